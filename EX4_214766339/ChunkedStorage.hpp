@@ -0,0 +1,325 @@
+//fadinujedat062@gmail.com
+#pragma once
+#include <vector>
+#include <memory>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+namespace containers {
+    /**
+     * @brief Segmented storage made of fixed-size chunks.
+     *
+     * Elements live in chunks of ChunkSize elements that are never moved once
+     * allocated; a small chunk index (a vector of chunk pointers) is the only
+     * thing that grows. Appending therefore never copies existing elements,
+     * which keeps push_back latency flat at any size.
+     *
+     * Provides the vector-like subset required by MyContainer, so it can be
+     * used as `MyContainer<T, ChunkedStorage<T>>`.
+     */
+    template<typename T, size_t ChunkSize = 4096, typename Alloc = std::allocator<T>>
+    class ChunkedStorage {
+        static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0,
+                      "ChunkSize must be a power of two");
+
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using const_reference = const T&;
+
+    private:
+        using alloc_traits = std::allocator_traits<Alloc>;
+        using index_allocator = typename alloc_traits::template rebind_alloc<T*>;
+
+        static constexpr size_t chunk_shift = [] {
+            size_t shift = 0;
+            while ((size_t(1) << shift) < ChunkSize) ++shift;
+            return shift;
+        }();
+        static constexpr size_t chunk_mask = ChunkSize - 1;
+
+        Alloc alloc;
+        std::vector<T*, index_allocator> chunks;///< Chunk index, one pointer per chunk
+        size_t count = 0;
+
+        /**
+         * @brief Iterator over the chunks in element order.
+         *
+         * Random access is resolved through the chunk index with a shift and a mask.
+         */
+        template<bool Const>
+        class basic_iterator {
+            using chunk_ptr = std::conditional_t<Const, T* const*, T**>;
+            chunk_ptr table = nullptr;
+            size_t index = 0;
+
+            friend class ChunkedStorage;
+            template<bool> friend class basic_iterator;
+
+            basic_iterator(chunk_ptr table, size_t index) : table(table), index(index) {}
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<Const, const T*, T*>;
+            using reference = std::conditional_t<Const, const T&, T&>;
+
+            basic_iterator() = default;
+
+            /**
+             * @brief Converts a mutable iterator to a const one.
+             */
+            template<bool C = Const, typename = std::enable_if_t<C>>
+            basic_iterator(const basic_iterator<false>& other) : table(other.table), index(other.index) {}
+
+            reference operator*() const { return table[index >> chunk_shift][index & chunk_mask]; }
+            pointer operator->() const { return &**this; }
+            reference operator[](difference_type n) const { return *(*this + n); }
+
+            basic_iterator& operator++() { ++index; return *this; }
+            basic_iterator operator++(int) { basic_iterator tmp = *this; ++index; return tmp; }
+            basic_iterator& operator--() { --index; return *this; }
+            basic_iterator operator--(int) { basic_iterator tmp = *this; --index; return tmp; }
+            basic_iterator& operator+=(difference_type n) { index += n; return *this; }
+            basic_iterator& operator-=(difference_type n) { index -= n; return *this; }
+
+            friend basic_iterator operator+(basic_iterator it, difference_type n) { return it += n; }
+            friend basic_iterator operator+(difference_type n, basic_iterator it) { return it += n; }
+            friend basic_iterator operator-(basic_iterator it, difference_type n) { return it -= n; }
+            friend difference_type operator-(const basic_iterator& a, const basic_iterator& b) {
+                return static_cast<difference_type>(a.index) - static_cast<difference_type>(b.index);
+            }
+
+            bool operator==(const basic_iterator& other) const { return index == other.index; }
+            bool operator!=(const basic_iterator& other) const { return index != other.index; }
+            bool operator<(const basic_iterator& other) const { return index < other.index; }
+            bool operator>(const basic_iterator& other) const { return index > other.index; }
+            bool operator<=(const basic_iterator& other) const { return index <= other.index; }
+            bool operator>=(const basic_iterator& other) const { return index >= other.index; }
+        };
+
+        /**
+         * @brief Destroys every element and releases every chunk.
+         */
+        void release() noexcept {
+            clear();
+            for (T* chunk : chunks) {
+                alloc_traits::deallocate(alloc, chunk, ChunkSize);
+            }
+            chunks.clear();
+        }
+
+    public:
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+
+        /**
+         * @brief Default constructor.
+         */
+        ChunkedStorage() = default;
+
+        /**
+         * @brief Constructs empty storage using the given allocator.
+         *
+         * @param alloc Allocator for both the chunks and the chunk index.
+         */
+        explicit ChunkedStorage(const Alloc& alloc) : alloc(alloc), chunks(index_allocator(alloc)) {}
+
+        /**
+         * @brief Constructs storage holding a copy of [first, last).
+         */
+        template<typename InputIt>
+        ChunkedStorage(InputIt first, InputIt last, const Alloc& alloc = Alloc()) : ChunkedStorage(alloc) {
+            assign(first, last);
+        }
+
+        /**
+         * @brief Copy constructor.
+         */
+        ChunkedStorage(const ChunkedStorage& other)
+            : ChunkedStorage(alloc_traits::select_on_container_copy_construction(other.alloc)) {
+            assign(other.begin(), other.end());
+        }
+
+        /**
+         * @brief Move constructor. Steals the chunk index; no element is moved.
+         */
+        ChunkedStorage(ChunkedStorage&& other) noexcept
+            : alloc(std::move(other.alloc)), chunks(std::move(other.chunks)), count(other.count) {
+            other.chunks.clear();
+            other.count = 0;
+        }
+
+        /**
+         * @brief Copy assignment. Keeps this storage's allocator.
+         */
+        ChunkedStorage& operator=(const ChunkedStorage& other) {
+            if (this != &other) {
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Move assignment. Steals the chunks when the allocators compare equal.
+         */
+        ChunkedStorage& operator=(ChunkedStorage&& other) {
+            if (this == &other) return *this;
+            if (alloc == other.alloc) {
+                release();
+                chunks = std::move(other.chunks);
+                count = other.count;
+                other.chunks.clear();
+                other.count = 0;
+            } else {
+                assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destructor.
+         */
+        ~ChunkedStorage() {
+            release();
+        }
+
+        allocator_type get_allocator() const { return alloc; }
+
+        /**
+         * @brief Appends an element. Allocates a new chunk only when the last one is full.
+         *
+         * @param value The element to append.
+         */
+        void push_back(const T& value) {
+            emplace_back(value);
+        }
+
+        /**
+         * @brief Appends an element by move.
+         */
+        void push_back(T&& value) {
+            emplace_back(std::move(value));
+        }
+
+        /**
+         * @brief Constructs an element in place at the end.
+         *
+         * @return T& Reference to the new element.
+         */
+        template<typename... Args>
+        T& emplace_back(Args&&... args) {
+            size_t chunk = count >> chunk_shift;
+            if (chunk == chunks.size()) {
+                T* fresh = alloc_traits::allocate(alloc, ChunkSize);
+                try {
+                    chunks.push_back(fresh);
+                } catch (...) {
+                    alloc_traits::deallocate(alloc, fresh, ChunkSize);
+                    throw;
+                }
+            }
+            T* slot = chunks[chunk] + (count & chunk_mask);
+            alloc_traits::construct(alloc, slot, std::forward<Args>(args)...);
+            ++count;
+            return *slot;
+        }
+
+        /**
+         * @brief Destroys the last element. Chunks are kept for reuse.
+         */
+        void pop_back() {
+            --count;
+            alloc_traits::destroy(alloc, &(*this)[count]);
+        }
+
+        /**
+         * @brief Erases [first, last), shifting the tail down.
+         *
+         * @return iterator Iterator to the element following the erased range.
+         */
+        iterator erase(const_iterator first, const_iterator last) {
+            iterator dest = begin() + (first - cbegin());
+            iterator src = begin() + (last - cbegin());
+            std::move(src, end(), dest);
+            size_t removed = static_cast<size_t>(last - first);
+            for (size_t i = 0; i < removed; ++i) {
+                pop_back();
+            }
+            return dest;
+        }
+
+        /**
+         * @brief Replaces the contents with a copy of [first, last).
+         */
+        template<typename InputIt>
+        void assign(InputIt first, InputIt last) {
+            clear();
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+
+        /**
+         * @brief Destroys all elements. Allocated chunks are kept for reuse.
+         */
+        void clear() noexcept {
+            if constexpr (std::is_trivially_destructible_v<T>) {
+                count = 0;
+            } else {
+                while (count > 0) {
+                    pop_back();
+                }
+            }
+        }
+
+        /**
+         * @brief Pre-sizes the chunk index so that n elements fit without growing it.
+         *
+         * @param n Expected number of elements.
+         */
+        void reserve(size_t n) {
+            chunks.reserve((n + ChunkSize - 1) >> chunk_shift);
+        }
+
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+
+        /**
+         * @brief Returns the size of each chunk in elements.
+         */
+        static constexpr size_t chunk_size() { return ChunkSize; }
+
+        T& operator[](size_t i) { return chunks[i >> chunk_shift][i & chunk_mask]; }
+        const T& operator[](size_t i) const { return chunks[i >> chunk_shift][i & chunk_mask]; }
+
+        /**
+         * @brief Bounds-checked element access.
+         *
+         * @throws std::out_of_range if i >= size().
+         */
+        const T& at(size_t i) const {
+            if (i >= count) {
+                throw std::out_of_range("ChunkedStorage index out of range");
+            }
+            return (*this)[i];
+        }
+
+        T& back() { return (*this)[count - 1]; }
+        const T& back() const { return (*this)[count - 1]; }
+
+        iterator begin() { return iterator(chunks.data(), 0); }
+        iterator end() { return iterator(chunks.data(), count); }
+        const_iterator begin() const { return const_iterator(chunks.data(), 0); }
+        const_iterator end() const { return const_iterator(chunks.data(), count); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+    };
+
+}
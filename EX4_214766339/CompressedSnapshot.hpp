@@ -0,0 +1,147 @@
+//fadinujedat062@gmail.com
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "MappedFile.hpp"
+#include "Snapshot.hpp"
+
+namespace containers {
+    /**
+     * @brief Streaming reader of a delta-varint snapshot written by MyContainer::save_compressed().
+     *
+     * Maps the file and decodes one varint per step, so the ascending
+     * traversal starts immediately and only touches the pages it reaches;
+     * the file is never decompressed as a whole.
+     */
+    template<typename T>
+    class CompressedSnapshot {
+        static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "Compressed snapshots hold integral elements");
+
+    private:
+        using U = std::make_unsigned_t<T>;
+
+        detail::MappedFile file;
+        snapshot::Header header{};
+        const char* payload = nullptr;
+
+    public:
+        /**
+         * @brief Forward iterator decoding the ascending order on the fly.
+         */
+        class DecodingIterator {
+            const char* p = nullptr;
+            const char* end = nullptr;
+            size_t count = 0;
+            size_t index = 0;
+            T value{};
+
+            friend class CompressedSnapshot;
+
+            DecodingIterator(const char* p, const char* end, size_t count, bool begin)
+                : p(p), end(end), count(count), index(begin ? 0 : count) {
+                if (begin && count > 0) {
+                    value = static_cast<T>(snapshot::unzigzag(snapshot::read_varint(this->p, end)));
+                }
+            }
+
+        public:
+            DecodingIterator() = default;
+
+            /**
+             * @brief Dereference operator.
+             *
+             * @return const T& The current element.
+             * @throws std::out_of_range if attempting to dereference end().
+             */
+            const T& operator*() const {
+                if (index >= count) {
+                    throw std::out_of_range("Dereferencing end() iterator");
+                }
+                return value;
+            }
+
+            /**
+             * @brief Decodes the next delta.
+             *
+             * @throws std::runtime_error if the payload ends early.
+             */
+            DecodingIterator& operator++() {
+                if (++index < count) {
+                    value = static_cast<T>(static_cast<U>(static_cast<U>(value) + static_cast<U>(snapshot::read_varint(p, end))));
+                }
+                return *this;
+            }
+
+            bool operator!=(const DecodingIterator& other) const {
+                return index != other.index;
+            }
+
+            bool operator==(const DecodingIterator& other) const {
+                return index == other.index;
+            }
+
+            size_t position() const {
+                return index;
+            }
+        };
+
+        using AscendingOrderIterator = DecodingIterator;
+
+        /**
+         * @brief Maps a compressed snapshot and validates its header.
+         *
+         * @param path File written by save_compressed().
+         * @throws std::runtime_error if the file is missing, truncated, not compressed or holds another type.
+         */
+        explicit CompressedSnapshot(const std::string& path) : file(path, true) {
+            if (file.size() < sizeof(header)) {
+                throw std::runtime_error("Snapshot is truncated");
+            }
+            std::memcpy(&header, file.data(), sizeof(header));
+            snapshot::validate<T>(header, file.size());
+            if ((header.flags & snapshot::DELTA_VARINT) == 0) {
+                throw std::runtime_error("Snapshot is not compressed");
+            }
+            payload = file.data() + sizeof(header);
+        }
+
+        /**
+         * @brief Returns the number of elements.
+         */
+        size_t size() const {
+            return static_cast<size_t>(header.count);
+        }
+
+        /**
+         * @brief Returns the size of the compressed payload in bytes.
+         */
+        size_t compressed_bytes() const {
+            return static_cast<size_t>(header.payload_bytes);
+        }
+
+        /**
+         * @brief Checks the payload checksum.
+         *
+         * @throws std::runtime_error on mismatch.
+         */
+        void verify() const {
+            snapshot::Checksum checksum;
+            checksum.update(payload, header.payload_bytes);
+            if (checksum.value() != header.checksum) {
+                throw std::runtime_error("Snapshot checksum mismatch");
+            }
+        }
+
+        AscendingOrderIterator begin_ascending_order() const {
+            return AscendingOrderIterator(payload, payload + header.payload_bytes, size(), true);
+        }
+
+        AscendingOrderIterator end_ascending_order() const {
+            return AscendingOrderIterator(nullptr, nullptr, size(), false);
+        }
+    };
+
+}
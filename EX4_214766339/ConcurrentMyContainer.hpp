@@ -0,0 +1,293 @@
+//fadinujedat062@gmail.com
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include "MyContainer.hpp"
+#include "KWayMerge.hpp"
+
+namespace containers {
+    /**
+     * @brief Multi-producer container with per-thread append buffers.
+     *
+     * Every inserting thread owns a private append-only buffer, so addElement
+     * never takes a lock and never contends with other producers. The only
+     * synchronization on the hot path is a release store of the buffer size.
+     * snapshot() merges all buffers into a regular MyContainer whose iterators
+     * can then be used as usual.
+     */
+    template<typename T = int>
+    class ConcurrentMyContainer {
+    private:
+        /**
+         * @brief Single-producer buffer made of geometrically growing segments.
+         *
+         * Segments are never moved once published, so readers can copy the
+         * published prefix while the owning thread keeps appending.
+         */
+        struct alignas(64) ThreadBuffer {
+            static constexpr size_t FIRST_SEGMENT = 1024;
+            static constexpr size_t MAX_SEGMENTS = 48;
+
+            std::atomic<T*> segments[MAX_SEGMENTS] = {};
+            std::atomic<size_t> published{0};
+
+            // Owned by the producing thread only.
+            size_t segment = 0;
+            size_t offset = 0;
+            size_t capacity = 0;
+
+            static size_t segment_size(size_t k) {
+                return FIRST_SEGMENT << k;
+            }
+
+            void push(const T& value) {
+                if (offset == capacity) {
+                    size_t next = capacity == 0 ? 0 : segment + 1;
+                    if (next == MAX_SEGMENTS) {
+                        throw std::length_error("ConcurrentMyContainer thread buffer is full");
+                    }
+                    T* storage = std::allocator<T>().allocate(segment_size(next));
+                    segments[next].store(storage, std::memory_order_release);
+                    segment = next;
+                    offset = 0;
+                    capacity = segment_size(next);
+                }
+                T* slot = segments[segment].load(std::memory_order_relaxed) + offset;
+                new (slot) T(value);
+                ++offset;
+                published.store(published.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            }
+
+            /**
+             * @brief Calls fn on every element of the published prefix, in insertion order.
+             */
+            template<typename Fn>
+            void for_each_published(Fn&& fn) const {
+                size_t remaining = published.load(std::memory_order_acquire);
+                for (size_t k = 0; remaining > 0; ++k) {
+                    const T* storage = segments[k].load(std::memory_order_acquire);
+                    size_t n = std::min(remaining, segment_size(k));
+                    for (size_t i = 0; i < n; ++i) {
+                        fn(storage[i]);
+                    }
+                    remaining -= n;
+                }
+            }
+
+            ~ThreadBuffer() {
+                size_t remaining = published.load(std::memory_order_acquire);
+                for (size_t k = 0; k < MAX_SEGMENTS; ++k) {
+                    T* storage = segments[k].load(std::memory_order_acquire);
+                    if (!storage) break;
+                    size_t n = std::min(remaining, segment_size(k));
+                    for (size_t i = 0; i < n; ++i) {
+                        storage[i].~T();
+                    }
+                    remaining -= n;
+                    std::allocator<T>().deallocate(storage, segment_size(k));
+                }
+            }
+        };
+
+        /**
+         * @brief Per-thread lookup entry from container to its buffer.
+         *
+         * The token expires with the container, which lets a thread prune
+         * entries of destroyed containers when it registers a new buffer.
+         */
+        struct LocalEntry {
+            uint64_t id;
+            std::weak_ptr<void> token;
+            ThreadBuffer* buffer;
+        };
+
+        struct LocalCache {
+            uint64_t last_id = 0;
+            ThreadBuffer* last_buffer = nullptr;
+            std::vector<LocalEntry> entries;
+        };
+
+        static LocalCache& local_cache() {
+            thread_local LocalCache cache;
+            return cache;
+        }
+
+        static uint64_t next_id() {
+            static std::atomic<uint64_t> counter{0};
+            return ++counter;
+        }
+
+        const uint64_t id = next_id();
+        std::shared_ptr<void> token = std::make_shared<char>(0);
+        mutable std::mutex registry_mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;///< One buffer per producer thread
+
+        /**
+         * @brief Returns the calling thread's buffer, registering one on first use.
+         */
+        ThreadBuffer& local_buffer() {
+            LocalCache& cache = local_cache();
+            if (cache.last_id == id) {
+                return *cache.last_buffer;
+            }
+            for (const LocalEntry& entry : cache.entries) {
+                if (entry.id == id) {
+                    cache.last_id = id;
+                    cache.last_buffer = entry.buffer;
+                    return *entry.buffer;
+                }
+            }
+            cache.entries.erase(std::remove_if(cache.entries.begin(), cache.entries.end(),
+                                               [](const LocalEntry& e) { return e.token.expired(); }),
+                                cache.entries.end());
+            ThreadBuffer* buffer;
+            {
+                std::lock_guard<std::mutex> lock(registry_mutex);
+                buffers.push_back(std::make_unique<ThreadBuffer>());
+                buffer = buffers.back().get();
+            }
+            cache.entries.push_back({id, token, buffer});
+            cache.last_id = id;
+            cache.last_buffer = buffer;
+            return *buffer;
+        }
+
+    public:
+        /**
+         * @brief Default constructor.
+         */
+        ConcurrentMyContainer() = default;
+
+        ConcurrentMyContainer(const ConcurrentMyContainer&) = delete;
+        ConcurrentMyContainer& operator=(const ConcurrentMyContainer&) = delete;
+
+        /**
+         * @brief Adds a new element from any thread without locking.
+         *
+         * The first insertion from a thread registers its buffer (one lock);
+         * every later insertion only touches that thread's buffer.
+         * @param value The element to insert.
+         */
+        void addElement(const T& value) {
+            local_buffer().push(value);
+        }
+
+        /**
+         * @brief Returns the number of elements published so far.
+         *
+         * @return size_t Sum of all thread buffer sizes.
+         */
+        size_t size() const {
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            size_t total = 0;
+            for (const auto& buffer : buffers) {
+                total += buffer->published.load(std::memory_order_acquire);
+            }
+            return total;
+        }
+
+        /**
+         * @brief Returns the number of producer threads that have inserted so far.
+         */
+        size_t shard_count() const {
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            return buffers.size();
+        }
+
+        /**
+         * @brief Merges all thread buffers into a regular MyContainer.
+         *
+         * The snapshot holds every insertion that happened before the call and
+         * keeps each thread's insertions in their original order, one thread's
+         * buffer after another. Insertions racing with the call may or may not
+         * be included. Producers are never blocked.
+         * @return MyContainer<T> Independent copy usable with every iterator type.
+         */
+        MyContainer<T> snapshot() const {
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            std::vector<T> elements;
+            size_t total = 0;
+            for (const auto& buffer : buffers) {
+                total += buffer->published.load(std::memory_order_acquire);
+            }
+            elements.reserve(total);
+            for (const auto& buffer : buffers) {
+                buffer->for_each_published([&elements](const T& value) { elements.push_back(value); });
+            }
+            return MyContainer<T>(std::move(elements));
+        }
+
+        /**
+         * @brief Sorts every thread buffer in parallel and merges the runs.
+         *
+         * Each shard is copied and sorted on its own pool task; the sorted runs
+         * are then combined by a splitter-partitioned parallel loser-tree merge,
+         * so no single thread ever sorts the whole content.
+         * @param pool Pool executing the shard sorts and the merge.
+         * @return std::vector<T> Every published element in ascending order.
+         */
+        std::vector<T> sorted_snapshot(WorkStealingPool& pool = WorkStealingPool::instance()) const {
+            std::vector<std::vector<T>> runs;
+            {
+                std::lock_guard<std::mutex> lock(registry_mutex);
+                runs.resize(buffers.size());
+                for (size_t i = 0; i < buffers.size(); ++i) {
+                    runs[i].reserve(buffers[i]->published.load(std::memory_order_acquire));
+                    buffers[i]->for_each_published([&run = runs[i]](const T& value) { run.push_back(value); });
+                }
+            }
+            pool.parallel_for(0, runs.size(), 1, [&runs](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    std::sort(runs[i].begin(), runs[i].end());
+                }
+            });
+            std::vector<SortedRun<T>> views;
+            for (const auto& run : runs) {
+                views.emplace_back(run.data(), run.data() + run.size());
+            }
+            std::vector<T> merged;
+            parallel_multiway_merge(views, merged, pool);
+            return merged;
+        }
+
+        /**
+         * @brief Returns begin and end of ascending order over one snapshot of all shards.
+         *
+         * Both ends share one sorted_snapshot(), so the range covers exactly
+         * that snapshot while producers keep inserting. Prefer it over the
+         * begin/end pair below when producers may be running.
+         * @return IteratorRange over the sorted snapshot.
+         */
+        IteratorRange<typename MyContainer<T>::AscendingOrderIterator> ascending_order() const {
+            return MyContainer<T>::AscendingOrderIterator::from_sorted(sorted_snapshot(), true).split(1).front();
+        }
+
+        /**
+         * @brief Returns an iterator to the beginning of ascending order over all shards.
+         *
+         * Built from sorted_snapshot(), without a global sort.
+         * @return MyContainer<T>::AscendingOrderIterator
+         */
+        typename MyContainer<T>::AscendingOrderIterator begin_ascending_order() const {
+            return MyContainer<T>::AscendingOrderIterator::from_sorted(sorted_snapshot(), true);
+        }
+
+        /**
+         * @brief Returns the end sentinel of ascending order over all shards.
+         *
+         * Compares equal to any ascending iterator at the end of its own
+         * snapshot, so it ends a traversal started by begin_ascending_order()
+         * even if producers inserted between the two calls.
+         * @return MyContainer<T>::AscendingOrderIterator
+         */
+        typename MyContainer<T>::AscendingOrderIterator end_ascending_order() const {
+            return MyContainer<T>::AscendingOrderIterator::end_of(size());
+        }
+    };
+
+}
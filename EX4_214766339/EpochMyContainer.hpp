@@ -0,0 +1,303 @@
+//fadinujedat062@gmail.com
+#pragma once
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "MyContainer.hpp"
+
+namespace containers {
+    /**
+     * @brief Single-writer, many-reader container using epoch-based reclamation.
+     *
+     * The writer mutates a private staging container and publish()es it as an
+     * immutable Version: two plain buffers holding the insertion and the
+     * ascending order, from which every traversal order is read. The writer
+     * keeps the ascending buffer up to date by merging the changes since the
+     * previous publication into it. Readers pin the current epoch, read the
+     * published Version without any lock, and unpin. A replaced Version is retired and freed by
+     * the writer once no reader pinned at or before its retirement epoch
+     * remains. Readers never wait for the writer and the writer never waits
+     * for readers.
+     */
+    template<typename T = int>
+    class EpochMyContainer {
+    public:
+        /**
+         * @brief Immutable published state of the container.
+         *
+         * Holds no lock or cache: all six orders are index arithmetic over the two buffers.
+         */
+        struct Version {
+            std::vector<T> elements;///< Elements in insertion order
+            std::vector<T> ascending;///< Elements in ascending order
+            uint64_t number = 0;///< Publication counter, 0 for the initial empty version
+
+            size_t size() const {
+                return elements.size();
+            }
+
+            /**
+             * @brief Calls fn(const T&) on every element in the given traversal order.
+             */
+            template<typename Fn>
+            void for_each(Order order, Fn&& fn) const {
+                const size_t n = elements.size();
+                switch (order) {
+                    case Order::Ascending:
+                        for (size_t k = 0; k < n; ++k) fn(ascending[k]);
+                        break;
+                    case Order::Descending:
+                        for (size_t k = n; k > 0; --k) fn(ascending[k - 1]);
+                        break;
+                    case Order::SideCross:
+                        for (size_t k = 0; k < n; ++k) fn(ascending[detail::side_cross_index(n, k)]);
+                        break;
+                    case Order::Reverse:
+                        for (size_t k = n; k > 0; --k) fn(elements[k - 1]);
+                        break;
+                    case Order::Insertion:
+                        for (size_t k = 0; k < n; ++k) fn(elements[k]);
+                        break;
+                    case Order::MiddleOut:
+                        for (size_t k = 0; k < n; ++k) fn(elements[detail::middle_out_index(n, k)]);
+                        break;
+                }
+            }
+        };
+
+        static constexpr size_t MAX_READERS = 128;
+
+    private:
+        /**
+         * @brief Per-reader announcement of the pinned epoch (0 = not reading).
+         */
+        struct alignas(64) ReaderSlot {
+            std::atomic<bool> in_use{false};
+            std::atomic<uint64_t> epoch{0};
+        };
+
+        struct Retired {
+            const Version* version;
+            uint64_t epoch;
+        };
+
+        mutable ReaderSlot slots[MAX_READERS];
+        std::atomic<uint64_t> global_epoch{1};
+        std::atomic<const Version*> current;
+
+        // Writer-only state.
+        MyContainer<T> staging;
+        std::vector<T> added;///< Values added since the last publication and still present
+        std::vector<T> removed;///< Values removed since the last publication
+        std::vector<Retired> retired;
+        uint64_t published = 0;
+
+        /**
+         * @brief Returns the ascending order of the staging state.
+         *
+         * Drops the removed values from the previous ascending order and
+         * merges in the sorted additions: O(n + k log k) for k changes.
+         */
+        std::vector<T> merged_ascending(const std::vector<T>& previous) {
+            std::sort(added.begin(), added.end());
+            std::sort(removed.begin(), removed.end());
+            std::vector<T> ascending;
+            ascending.reserve(staging.size());
+            auto kept = previous.begin();
+            for (const T& value : added) {
+                for (; kept != previous.end() && !(value < *kept); ++kept) {
+                    if (!std::binary_search(removed.begin(), removed.end(), *kept)) ascending.push_back(*kept);
+                }
+                ascending.push_back(value);
+            }
+            for (; kept != previous.end(); ++kept) {
+                if (!std::binary_search(removed.begin(), removed.end(), *kept)) ascending.push_back(*kept);
+            }
+            return ascending;
+        }
+
+        /**
+         * @brief Claims a free reader slot.
+         *
+         * @throws std::runtime_error if MAX_READERS readers are already active.
+         */
+        ReaderSlot& acquire_slot() const {
+            thread_local size_t hint = 0;
+            for (size_t i = 0; i < MAX_READERS; ++i) {
+                size_t s = (hint + i) % MAX_READERS;
+                bool expected = false;
+                ReaderSlot& slot = slots[s];
+                if (!slot.in_use.load(std::memory_order_relaxed) &&
+                    slot.in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                    hint = s;
+                    return slot;
+                }
+            }
+            throw std::runtime_error("Too many concurrent readers");
+        }
+
+        /**
+         * @brief Frees every retired version that no pinned reader can still observe.
+         */
+        void reclaim() {
+            uint64_t oldest = std::numeric_limits<uint64_t>::max();
+            for (const ReaderSlot& slot : slots) {
+                uint64_t e = slot.epoch.load(std::memory_order_seq_cst);
+                if (e != 0) oldest = std::min(oldest, e);
+            }
+            auto keep = std::remove_if(retired.begin(), retired.end(), [oldest](const Retired& r) {
+                if (r.epoch < oldest) {
+                    delete r.version;
+                    return true;
+                }
+                return false;
+            });
+            retired.erase(keep, retired.end());
+        }
+
+    public:
+        /**
+         * @brief RAII pin on a published version.
+         *
+         * While alive, the referenced Version is guaranteed not to be freed.
+         */
+        class ReadGuard {
+            ReaderSlot* slot = nullptr;
+            const Version* version = nullptr;
+
+            friend class EpochMyContainer;
+
+            ReadGuard(ReaderSlot& slot, const Version* version) : slot(&slot), version(version) {}
+
+        public:
+            ReadGuard(const ReadGuard&) = delete;
+            ReadGuard& operator=(const ReadGuard&) = delete;
+
+            ReadGuard(ReadGuard&& other) noexcept : slot(other.slot), version(other.version) {
+                other.slot = nullptr;
+                other.version = nullptr;
+            }
+
+            ~ReadGuard() {
+                if (slot) {
+                    slot->epoch.store(0, std::memory_order_release);
+                    slot->in_use.store(false, std::memory_order_release);
+                }
+            }
+
+            const Version& operator*() const { return *version; }
+            const Version* operator->() const { return version; }
+
+            /**
+             * @brief Returns the pinned elements in insertion order.
+             */
+            const std::vector<T>& elements() const { return version->elements; }
+
+            /**
+             * @brief Returns the pinned, pre-sorted ascending ordering.
+             */
+            const std::vector<T>& ascending() const { return version->ascending; }
+        };
+
+        /**
+         * @brief Constructs a container whose initial published version is empty.
+         */
+        EpochMyContainer() : current(new Version()) {}
+
+        EpochMyContainer(const EpochMyContainer&) = delete;
+        EpochMyContainer& operator=(const EpochMyContainer&) = delete;
+
+        /**
+         * @brief Destructor. No reader may be active.
+         */
+        ~EpochMyContainer() {
+            delete current.load();
+            for (const Retired& r : retired) {
+                delete r.version;
+            }
+        }
+
+        /**
+         * @brief Adds an element to the writer's staging state.
+         *
+         * Readers see it after the next publish().
+         * @param value The element to insert.
+         */
+        void addElement(const T& value) {
+            staging.addElement(value);
+            added.push_back(value);
+        }
+
+        /**
+         * @brief Removes all occurrences of value from the writer's staging state.
+         *
+         * @param value The value to remove.
+         * @throws std::runtime_error if the value is not found.
+         */
+        void remove(const T& value) {
+            staging.remove(value);
+            added.erase(std::remove(added.begin(), added.end(), value), added.end());
+            removed.push_back(value);
+        }
+
+        /**
+         * @brief Returns the number of elements in the writer's staging state.
+         */
+        size_t size() const {
+            return staging.size();
+        }
+
+        /**
+         * @brief Publishes the staging state as a new immutable version.
+         *
+         * Copies the insertion order, merges the changes since the previous
+         * publication into its ascending order instead of sorting everything,
+         * swaps the version pointer, retires the previous version and frees
+         * every version no reader still holds.
+         * @return uint64_t Number of the published version.
+         */
+        uint64_t publish() {
+            auto next = std::make_unique<Version>();
+            next->elements.assign(staging.get_data().begin(), staging.get_data().end());
+            next->ascending = merged_ascending(current.load(std::memory_order_relaxed)->ascending);
+            next->number = ++published;
+
+            const uint64_t number = next->number;
+            retired.reserve(retired.size() + 1);
+            const Version* old = current.exchange(next.release(), std::memory_order_seq_cst);
+            added.clear();
+            removed.clear();
+            uint64_t epoch = global_epoch.fetch_add(1, std::memory_order_seq_cst);
+            retired.push_back({old, epoch});
+            reclaim();
+            return number;
+        }
+
+        /**
+         * @brief Pins the current epoch and returns the published version.
+         *
+         * Lock-free: claims a reader slot, announces the epoch and loads the version pointer.
+         * @return ReadGuard Pin that keeps the version alive until destroyed.
+         * @throws std::runtime_error if MAX_READERS readers are already active.
+         */
+        ReadGuard read() const {
+            ReaderSlot& slot = acquire_slot();
+            slot.epoch.store(global_epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+            const Version* version = current.load(std::memory_order_seq_cst);
+            return ReadGuard(slot, version);
+        }
+
+        /**
+         * @brief Returns how many replaced versions are still waiting for readers to leave.
+         *
+         * Writer-side only.
+         */
+        size_t retired_count() const {
+            return retired.size();
+        }
+    };
+
+}
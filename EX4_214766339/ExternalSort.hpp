@@ -0,0 +1,362 @@
+//fadinujedat062@gmail.com
+#pragma once
+#include <algorithm>
+#include <cerrno>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <stdlib.h>
+#include <unistd.h>
+#include "KWayMerge.hpp"
+
+namespace containers {
+    /**
+     * @brief Sorted traversal of data larger than memory.
+     *
+     * The constructor reads the input once, sorts it in runs that fit the
+     * memory budget and spills every run to an unlinked temporary file.
+     * Whenever MAX_FAN_IN runs of the same merge level pile up they are merged
+     * into one run of the next level, so the number of open run files stays
+     * logarithmic in the input, and at most MAX_FAN_IN remain at the end.
+     * Ascending and descending traversals then stream a loser-tree merge over
+     * the runs, reading each through a bounded buffer (descending reads the
+     * runs back to front). The iterators offer the usual interface, but they
+     * are single-pass: copies share the merge state and advance together.
+     * The sorter must outlive its iterators and must not be moved while they
+     * are in use.
+     */
+    template<typename T>
+    class ExternalSort {
+        static_assert(std::is_trivially_copyable_v<T>, "External sorting spills raw bytes and needs trivially copyable elements");
+
+    public:
+        /**
+         * @brief Largest number of runs merged at once.
+         */
+        static constexpr size_t MAX_FAN_IN = 64;
+
+    private:
+        struct Run {
+            int fd;
+            size_t count;
+            size_t level;///< Number of merge passes the run went through
+        };
+
+        std::vector<Run> runs;
+        size_t total = 0;
+        size_t budget_elements = 0;
+
+        static void write_all(int fd, const T* p, size_t n) {
+            const char* bytes = reinterpret_cast<const char*>(p);
+            size_t left = n * sizeof(T);
+            while (left > 0) {
+                ssize_t written = ::write(fd, bytes, left);
+                if (written < 0) {
+                    if (errno == EINTR) continue;
+                    throw std::runtime_error("Failed to write sort run");
+                }
+                bytes += written;
+                left -= static_cast<size_t>(written);
+            }
+        }
+
+        static void read_at(int fd, T* p, size_t n, size_t first) {
+            char* bytes = reinterpret_cast<char*>(p);
+            size_t left = n * sizeof(T);
+            off_t offset = static_cast<off_t>(first * sizeof(T));
+            while (left > 0) {
+                ssize_t got = ::pread(fd, bytes, left, offset);
+                if (got < 0 && errno == EINTR) continue;
+                if (got <= 0) {
+                    throw std::runtime_error("Failed to read sort run");
+                }
+                bytes += got;
+                left -= static_cast<size_t>(got);
+                offset += got;
+            }
+        }
+
+        static int create_run(const std::string& directory) {
+            std::string name = (std::filesystem::path(directory) / "mycontainer_run_XXXXXX").string();
+            int fd = ::mkstemp(name.data());
+            if (fd < 0) {
+                throw std::runtime_error("Cannot create sort run in " + directory);
+            }
+            ::unlink(name.c_str());
+            return fd;
+        }
+
+        void close_runs() {
+            for (const Run& run : runs) {
+                ::close(run.fd);
+            }
+            runs.clear();
+        }
+
+        void spill(std::vector<T>& buffer, const std::string& directory) {
+            std::sort(buffer.begin(), buffer.end());
+            int fd = create_run(directory);
+            runs.push_back({fd, buffer.size(), 0});
+            write_all(fd, buffer.data(), buffer.size());
+            buffer.clear();
+            while (runs.size() >= MAX_FAN_IN && runs[runs.size() - MAX_FAN_IN].level == runs.back().level) {
+                merge_tail(MAX_FAN_IN, directory);
+            }
+        }
+
+        /**
+         * @brief Merge of all runs in one direction, streamed through one buffer per run.
+         *
+         * Forward merges read each run front to back; backward merges read it
+         * back to front and reverse every block, so the blocks are sorted by
+         * Compare either way.
+         */
+        template<typename Compare>
+        struct MergeState {
+            const ExternalSort* sorter;
+            bool backward;
+            size_t first_run;
+            size_t block;
+            std::vector<std::vector<T>> buffers;
+            std::vector<size_t> consumed;///< Elements of each run read so far
+            std::unique_ptr<LoserTree<T, Compare>> tree;
+
+            /**
+             * @brief Merges the run_count runs starting at first_run, within budget / (run_count + extra) elements per buffer.
+             */
+            MergeState(const ExternalSort* sorter, bool backward, size_t first_run, size_t run_count, size_t extra = 0)
+                : sorter(sorter), backward(backward), first_run(first_run), buffers(run_count), consumed(run_count, 0) {
+                block = std::max<size_t>(sorter->budget_elements / std::max<size_t>(run_count + extra, 1), 64);
+                std::vector<SortedRun<T>> blocks;
+                for (size_t r = 0; r < run_count; ++r) {
+                    blocks.push_back(next_block(r));
+                }
+                tree = std::make_unique<LoserTree<T, Compare>>(blocks);
+            }
+
+            MergeState(const ExternalSort* sorter, bool backward)
+                : MergeState(sorter, backward, 0, sorter->runs.size()) {}
+
+            SortedRun<T> next_block(size_t r) {
+                const Run& run = sorter->runs[first_run + r];
+                size_t n = std::min(block, run.count - consumed[r]);
+                std::vector<T>& buffer = buffers[r];
+                buffer.resize(n);
+                if (n > 0) {
+                    size_t first = backward ? run.count - consumed[r] - n : consumed[r];
+                    read_at(run.fd, buffer.data(), n, first);
+                    if (backward) std::reverse(buffer.begin(), buffer.end());
+                }
+                consumed[r] += n;
+                return SortedRun<T>(buffer.data(), buffer.data() + n);
+            }
+        };
+
+        /**
+         * @brief Replaces the last k runs with one run holding their merge.
+         *
+         * The output block shares the memory budget with the k input buffers.
+         */
+        void merge_tail(size_t k, const std::string& directory) {
+            const size_t first = runs.size() - k;
+            size_t count = 0;
+            size_t level = 0;
+            for (size_t r = first; r < runs.size(); ++r) {
+                count += runs[r].count;
+                level = std::max(level, runs[r].level);
+            }
+            int fd = create_run(directory);
+            try {
+                MergeState<std::less<T>> merge(this, false, first, k, 1);
+                std::vector<T> out;
+                out.reserve(merge.block);
+                for (size_t i = 0; i < count; ++i) {
+                    out.push_back(merge.tree->top());
+                    merge.tree->pop([&merge](size_t run) { return merge.next_block(run); });
+                    if (out.size() == merge.block) {
+                        write_all(fd, out.data(), out.size());
+                        out.clear();
+                    }
+                }
+                write_all(fd, out.data(), out.size());
+            } catch (...) {
+                ::close(fd);
+                throw;
+            }
+            for (size_t r = first; r < runs.size(); ++r) {
+                ::close(runs[r].fd);
+            }
+            runs.resize(first);
+            runs.push_back({fd, count, level + 1});
+        }
+
+    public:
+        /**
+         * @brief Single-pass iterator streaming the merge.
+         */
+        template<typename Compare>
+        class MergeIterator {
+            std::shared_ptr<MergeState<Compare>> state;
+            size_t count = 0;
+            size_t index = 0;
+
+            friend class ExternalSort;
+
+            MergeIterator(std::shared_ptr<MergeState<Compare>> state, size_t count, bool begin)
+                : state(std::move(state)), count(count), index(begin ? 0 : count) {}
+
+        public:
+            MergeIterator() = default;
+
+            /**
+             * @brief Dereference operator.
+             *
+             * @return const T& Reference valid until the iterator is advanced.
+             * @throws std::out_of_range if attempting to dereference end().
+             */
+            const T& operator*() const {
+                if (!state || index >= count) {
+                    throw std::out_of_range("Dereferencing end() iterator");
+                }
+                return state->tree->top();
+            }
+
+            /**
+             * @brief Advances to the next element of the merge.
+             *
+             * @throws std::out_of_range if attempting to increment end() or a
+             *         default-constructed iterator.
+             */
+            MergeIterator& operator++() {
+                if (!state || index >= count) {
+                    throw std::out_of_range("Incrementing end() iterator");
+                }
+                MergeState<Compare>* merge = state.get();
+                merge->tree->pop([merge](size_t run) { return merge->next_block(run); });
+                ++index;
+                return *this;
+            }
+
+            bool operator!=(const MergeIterator& other) const {
+                return index != other.index;
+            }
+
+            bool operator==(const MergeIterator& other) const {
+                return index == other.index;
+            }
+
+            size_t position() const {
+                return index;
+            }
+        };
+
+        using AscendingOrderIterator = MergeIterator<std::less<T>>;
+        using DescendingOrderIterator = MergeIterator<std::greater<T>>;
+
+        /**
+         * @brief Sorts [first, last) into runs spilled under directory.
+         *
+         * @param first Start of the input; any iterator with ++, * and !=.
+         * @param last End of the input.
+         * @param memory_budget Bytes of elements held in memory while sorting a run or merging.
+         * @param directory Directory for the temporary run files.
+         * @throws std::invalid_argument if the budget is smaller than one element.
+         * @throws std::runtime_error if a run cannot be written.
+         */
+        template<typename It>
+        ExternalSort(It first, It last, size_t memory_budget,
+                     const std::string& directory = std::filesystem::temp_directory_path().string()) {
+            budget_elements = memory_budget / sizeof(T);
+            if (budget_elements == 0) {
+                throw std::invalid_argument("Memory budget is smaller than one element");
+            }
+            std::vector<T> buffer;
+            buffer.reserve(budget_elements);
+            try {
+                for (; first != last; ++first) {
+                    buffer.push_back(*first);
+                    if (buffer.size() == budget_elements) {
+                        spill(buffer, directory);
+                    }
+                    ++total;
+                }
+                if (!buffer.empty()) {
+                    spill(buffer, directory);
+                }
+                if (runs.size() > MAX_FAN_IN) {
+                    merge_tail(runs.size() - MAX_FAN_IN + 1, directory);
+                }
+            } catch (...) {
+                close_runs();
+                throw;
+            }
+        }
+
+        ExternalSort(const ExternalSort&) = delete;
+        ExternalSort& operator=(const ExternalSort&) = delete;
+
+        /**
+         * @brief Move constructor. Takes over the run files and leaves other empty.
+         */
+        ExternalSort(ExternalSort&& other) noexcept
+            : runs(std::exchange(other.runs, {})),
+              total(std::exchange(other.total, 0)),
+              budget_elements(other.budget_elements) {}
+
+        /**
+         * @brief Move assignment. Closes this sorter's runs and takes over other's.
+         */
+        ExternalSort& operator=(ExternalSort&& other) noexcept {
+            if (this != &other) {
+                close_runs();
+                runs = std::exchange(other.runs, {});
+                total = std::exchange(other.total, 0);
+                budget_elements = other.budget_elements;
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destructor. Closes the run files, which frees their disk space.
+         */
+        ~ExternalSort() {
+            close_runs();
+        }
+
+        /**
+         * @brief Returns the number of sorted elements.
+         */
+        size_t size() const {
+            return total;
+        }
+
+        /**
+         * @brief Returns the number of runs spilled to disk.
+         */
+        size_t run_count() const {
+            return runs.size();
+        }
+
+        AscendingOrderIterator begin_ascending_order() const {
+            return AscendingOrderIterator(std::make_shared<MergeState<std::less<T>>>(this, false), total, true);
+        }
+
+        AscendingOrderIterator end_ascending_order() const {
+            return AscendingOrderIterator(nullptr, total, false);
+        }
+
+        DescendingOrderIterator begin_descending_order() const {
+            return DescendingOrderIterator(std::make_shared<MergeState<std::greater<T>>>(this, true), total, true);
+        }
+
+        DescendingOrderIterator end_descending_order() const {
+            return DescendingOrderIterator(nullptr, total, false);
+        }
+    };
+
+}
@@ -0,0 +1,119 @@
+//fadinujedat062@gmail.com
+#pragma once
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace containers {
+    /**
+     * @brief Lazily evaluated sequence produced by a coroutine.
+     *
+     * Values are yielded by const reference and produced one at a time as the
+     * sequence is iterated; nothing is buffered. A Generator is move-only and
+     * can be traversed once with a range-based for loop.
+     */
+    template<typename T>
+    class Generator {
+    public:
+        struct promise_type {
+            const T* current = nullptr;
+            std::exception_ptr error;
+
+            Generator get_return_object() {
+                return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+
+            std::suspend_always yield_value(const T& value) noexcept {
+                current = std::addressof(value);
+                return {};
+            }
+
+            void return_void() noexcept {}
+
+            void unhandled_exception() {
+                error = std::current_exception();
+            }
+
+            template<typename U>
+            std::suspend_never await_transform(U&&) = delete;
+        };
+
+        struct sentinel {};
+
+        /**
+         * @brief Input iterator resuming the coroutine on every increment.
+         */
+        class iterator {
+            std::coroutine_handle<promise_type> handle;
+
+            friend class Generator;
+
+            explicit iterator(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+
+            const T& operator*() const { return *handle.promise().current; }
+            const T* operator->() const { return handle.promise().current; }
+
+            iterator& operator++() {
+                handle.resume();
+                if (handle.done() && handle.promise().error) {
+                    std::rethrow_exception(handle.promise().error);
+                }
+                return *this;
+            }
+
+            void operator++(int) { ++*this; }
+
+            bool operator==(sentinel) const { return !handle || handle.done(); }
+            bool operator!=(sentinel s) const { return !(*this == s); }
+        };
+
+    private:
+        std::coroutine_handle<promise_type> handle;
+
+        explicit Generator(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    public:
+        Generator(const Generator&) = delete;
+        Generator& operator=(const Generator&) = delete;
+
+        Generator(Generator&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+
+        Generator& operator=(Generator&& other) noexcept {
+            if (this != &other) {
+                if (handle) handle.destroy();
+                handle = std::exchange(other.handle, nullptr);
+            }
+            return *this;
+        }
+
+        ~Generator() {
+            if (handle) handle.destroy();
+        }
+
+        /**
+         * @brief Starts the coroutine and returns an iterator to the first value.
+         *
+         * @throws any exception escaping the coroutine body.
+         */
+        iterator begin() {
+            iterator it(handle);
+            if (handle) ++it;
+            return it;
+        }
+
+        sentinel end() const { return {}; }
+    };
+
+}
@@ -0,0 +1,211 @@
+//fadinujedat062@gmail.com
+#pragma once
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "WorkStealingPool.hpp"
+
+namespace containers {
+    /**
+     * @brief A sorted run given as a [first, last) pointer pair.
+     */
+    template<typename T>
+    using SortedRun = std::pair<const T*, const T*>;
+
+    /**
+     * @brief Tournament tree of losers over k sorted runs.
+     *
+     * The root holds the overall winner; every internal node stores the loser
+     * of the match played there. Popping the winner replays only the matches
+     * on the path from its leaf to the root, i.e. log2(k) comparisons.
+     * Ties are won by the run with the lower index, which keeps the merge stable.
+     */
+    template<typename T, typename Compare = std::less<T>>
+    class LoserTree {
+    private:
+        std::vector<const T*> cursor;///< Current position of each run
+        std::vector<const T*> limit;///< End of each run
+        std::vector<size_t> losers;///< Loser index per internal node, 1-based heap layout
+        size_t leaves = 1;
+        size_t winner = 0;
+        Compare comp;
+
+        bool exhausted(size_t run) const {
+            return run >= cursor.size() || cursor[run] == limit[run];
+        }
+
+        /**
+         * @brief Returns true if run a wins against run b.
+         */
+        bool beats(size_t a, size_t b) const {
+            if (exhausted(a)) return false;
+            if (exhausted(b)) return true;
+            if (comp(*cursor[a], *cursor[b])) return true;
+            if (comp(*cursor[b], *cursor[a])) return false;
+            return a < b;
+        }
+
+        size_t build(size_t node) {
+            if (node >= leaves) {
+                return node - leaves;
+            }
+            size_t left = build(2 * node);
+            size_t right = build(2 * node + 1);
+            if (beats(right, left)) {
+                losers[node] = left;
+                return right;
+            }
+            losers[node] = right;
+            return left;
+        }
+
+    public:
+        /**
+         * @brief Builds the tree over the given runs.
+         *
+         * @param runs Sorted runs; they must outlive the tree.
+         * @param comp Strict weak ordering the runs are sorted by.
+         */
+        explicit LoserTree(const std::vector<SortedRun<T>>& runs, Compare comp = Compare()) : comp(comp) {
+            for (const auto& run : runs) {
+                cursor.push_back(run.first);
+                limit.push_back(run.second);
+            }
+            while (leaves < runs.size()) leaves *= 2;
+            losers.assign(leaves, 0);
+            winner = build(1);
+        }
+
+        /**
+         * @brief Returns true when every run is exhausted.
+         */
+        bool empty() const {
+            return exhausted(winner);
+        }
+
+        /**
+         * @brief Returns the smallest remaining element.
+         */
+        const T& top() const {
+            return *cursor[winner];
+        }
+
+        /**
+         * @brief Removes the smallest remaining element.
+         */
+        void pop() {
+            pop([this](size_t run) { return SortedRun<T>(cursor[run], limit[run]); });
+        }
+
+        /**
+         * @brief Removes the smallest remaining element, refilling its run when it runs dry.
+         *
+         * Lets runs be streamed through bounded buffers: when the winner's
+         * run is exhausted, refill(run) returns the run's next sorted block,
+         * or an empty run once there is nothing left.
+         * @param refill Callable taking the run index and returning a SortedRun<T>.
+         */
+        template<typename Refill>
+        void pop(Refill&& refill) {
+            if (++cursor[winner] == limit[winner]) {
+                SortedRun<T> next = refill(winner);
+                cursor[winner] = next.first;
+                limit[winner] = next.second;
+            }
+            size_t current = winner;
+            for (size_t node = (winner + leaves) / 2; node >= 1; node /= 2) {
+                if (beats(losers[node], current)) {
+                    std::swap(losers[node], current);
+                }
+            }
+            winner = current;
+        }
+    };
+
+    /**
+     * @brief Merges sorted runs into out with a loser tree.
+     *
+     * @return OutputIt Iterator past the last written element.
+     */
+    template<typename T, typename OutputIt, typename Compare = std::less<T>>
+    OutputIt multiway_merge(const std::vector<SortedRun<T>>& runs, OutputIt out, Compare comp = Compare()) {
+        LoserTree<T, Compare> tree(runs, comp);
+        while (!tree.empty()) {
+            *out++ = tree.top();
+            tree.pop();
+        }
+        return out;
+    }
+
+    /**
+     * @brief Merges sorted runs into out in parallel.
+     *
+     * Splitter values sampled from all runs cut every run into aligned
+     * partitions; partition p of the output is the merge of partition p of
+     * every run, so partitions are merged independently with one loser tree
+     * each and written straight to their final offset.
+     * @param runs Sorted runs.
+     * @param out Destination, resized to the total length.
+     * @param pool Pool executing the partition merges.
+     * @param comp Strict weak ordering the runs are sorted by.
+     */
+    template<typename T, typename Alloc, typename Compare = std::less<T>>
+    void parallel_multiway_merge(const std::vector<SortedRun<T>>& runs, std::vector<T, Alloc>& out,
+                                 WorkStealingPool& pool = WorkStealingPool::instance(), Compare comp = Compare()) {
+        size_t total = 0;
+        for (const auto& run : runs) {
+            total += static_cast<size_t>(run.second - run.first);
+        }
+        out.resize(total);
+        size_t partitions = std::min<size_t>(pool.size() * 4, total / 4096 + 1);
+        if (partitions <= 1 || runs.size() <= 1) {
+            multiway_merge(runs, out.begin(), comp);
+            return;
+        }
+
+        std::vector<T> sample;
+        const size_t per_run = partitions * 4;
+        for (const auto& run : runs) {
+            size_t n = static_cast<size_t>(run.second - run.first);
+            for (size_t i = 1; i <= per_run && n > 0; ++i) {
+                sample.push_back(run.first[i * n / (per_run + 1)]);
+            }
+        }
+        std::sort(sample.begin(), sample.end(), comp);
+        std::vector<T> splitters;
+        for (size_t p = 1; p < partitions; ++p) {
+            splitters.push_back(sample[p * sample.size() / partitions]);
+        }
+
+        // bounds[p][r]: start of partition p in run r; partition p holds values
+        // greater than splitter p-1 and not greater than splitter p.
+        std::vector<std::vector<const T*>> bounds(partitions + 1, std::vector<const T*>(runs.size()));
+        for (size_t r = 0; r < runs.size(); ++r) {
+            bounds[0][r] = runs[r].first;
+            bounds[partitions][r] = runs[r].second;
+            for (size_t p = 1; p < partitions; ++p) {
+                bounds[p][r] = std::upper_bound(bounds[p - 1][r], runs[r].second, splitters[p - 1], comp);
+            }
+        }
+        std::vector<size_t> offsets(partitions + 1, 0);
+        for (size_t p = 0; p < partitions; ++p) {
+            size_t length = 0;
+            for (size_t r = 0; r < runs.size(); ++r) {
+                length += static_cast<size_t>(bounds[p + 1][r] - bounds[p][r]);
+            }
+            offsets[p + 1] = offsets[p] + length;
+        }
+
+        pool.parallel_for(0, partitions, 1, [&](size_t lo, size_t hi) {
+            for (size_t p = lo; p < hi; ++p) {
+                std::vector<SortedRun<T>> pieces;
+                for (size_t r = 0; r < runs.size(); ++r) {
+                    pieces.emplace_back(bounds[p][r], bounds[p + 1][r]);
+                }
+                multiway_merge(pieces, out.begin() + offsets[p], comp);
+            }
+        });
+    }
+
+}
@@ -0,0 +1,82 @@
+//fadinujedat062@gmail.com
+#pragma once
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace containers {
+    namespace detail {
+        /**
+         * @brief Read-only mapping of a whole file, unmapped on destruction.
+         *
+         * An empty file maps to an empty view without calling mmap.
+         */
+        class MappedFile {
+        private:
+            void* base = nullptr;
+            size_t length = 0;
+
+        public:
+            /**
+             * @brief Maps path read-only and shared.
+             *
+             * @param path File to map.
+             * @param sequential If true, advises the kernel to read ahead aggressively.
+             * @throws std::runtime_error if the file cannot be opened or mapped.
+             */
+            explicit MappedFile(const std::string& path, bool sequential = false) {
+                int fd = ::open(path.c_str(), O_RDONLY);
+                if (fd < 0) {
+                    throw std::runtime_error("Cannot open file: " + path);
+                }
+                struct stat info;
+                if (::fstat(fd, &info) != 0) {
+                    ::close(fd);
+                    throw std::runtime_error("Cannot open file: " + path);
+                }
+                length = static_cast<size_t>(info.st_size);
+                if (length > 0) {
+                    base = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+                }
+                ::close(fd);
+                if (base == MAP_FAILED) {
+                    base = nullptr;
+                    throw std::runtime_error("Cannot map file: " + path);
+                }
+                if (base && sequential) {
+                    ::madvise(base, length, MADV_SEQUENTIAL);
+                }
+            }
+
+            MappedFile(MappedFile&& other) noexcept
+                : base(std::exchange(other.base, nullptr)), length(std::exchange(other.length, 0)) {}
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+            MappedFile& operator=(MappedFile&&) = delete;
+
+            ~MappedFile() {
+                if (base) {
+                    ::munmap(base, length);
+                }
+            }
+
+            const char* data() const {
+                return static_cast<const char*>(base);
+            }
+
+            size_t size() const {
+                return length;
+            }
+
+            std::string_view view() const {
+                return std::string_view(data(), length);
+            }
+        };
+    }
+}
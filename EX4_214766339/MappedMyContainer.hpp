@@ -0,0 +1,194 @@
+//fadinujedat062@gmail.com
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "MyContainerView.hpp"
+#include "MappedFile.hpp"
+#include "Snapshot.hpp"
+
+namespace containers {
+    /**
+     * @brief Read-only container over a memory-mapped binary snapshot.
+     *
+     * Maps a file written by MyContainer::save() and traverses the elements
+     * in place, so opening costs one mmap regardless of the file size and
+     * the pages are shared with every other process mapping the same file.
+     * Traversals go through a MyContainerView over the mapped elements, so
+     * sorted orders use the permutation stored in the file when it was saved
+     * with one, and otherwise build an index permutation once, on first use.
+     * Iterators point into the mapping and must not outlive the container.
+     */
+    template<typename T = int>
+    class MappedMyContainer {
+        static_assert(std::is_trivially_copyable_v<T>, "Mapped snapshots need trivially copyable elements");
+
+    public:
+        using value_type = T;
+
+    private:
+        detail::MappedFile file;
+        snapshot::Header header{};
+        MyContainerView<T> view;///< Traversals over the mapped elements
+
+        static snapshot::Header read_mapped_header(const detail::MappedFile& file) {
+            if (file.size() < sizeof(snapshot::Header)) {
+                throw std::runtime_error("Snapshot is truncated");
+            }
+            snapshot::Header header;
+            std::memcpy(&header, file.data(), sizeof(header));
+            snapshot::validate<T>(header, file.size());
+            if (header.flags & snapshot::DELTA_VARINT) {
+                throw std::runtime_error("Compressed snapshots cannot be mapped");
+            }
+            return header;
+        }
+
+        static std::span<const T> elements_of(const detail::MappedFile& file, const snapshot::Header& header) {
+            if (header.count > (file.size() - sizeof(header)) / sizeof(T)) {
+                throw std::runtime_error("Snapshot is truncated");
+            }
+            return {reinterpret_cast<const T*>(file.data() + sizeof(header)), static_cast<size_t>(header.count)};
+        }
+
+        /**
+         * @brief Returns the permutation section of the file, or an empty span if it has none.
+         */
+        static std::span<const uint64_t> permutation_of(const detail::MappedFile& file, const snapshot::Header& header) {
+            if ((header.flags & snapshot::ASCENDING_PERMUTATION) == 0) {
+                return {};
+            }
+            const size_t length = file.size();
+            uint64_t offset = snapshot::permutation_offset(header.payload_bytes) + sizeof(uint64_t);
+            if (offset > length || (length - offset) / sizeof(uint64_t) < header.count) {
+                throw std::runtime_error("Snapshot is truncated");
+            }
+            return {reinterpret_cast<const uint64_t*>(file.data() + offset), static_cast<size_t>(header.count)};
+        }
+
+    public:
+        using MappedIterator = typename MyContainerView<T>::ViewIterator;
+        using AscendingOrderIterator = MappedIterator;
+        using DescendingOrderIterator = MappedIterator;
+        using SideCrossOrderIterator = MappedIterator;
+        using ReverseOrderIterator = MappedIterator;
+        using OrderIterator = MappedIterator;
+        using MiddleOutOrderIterator = MappedIterator;
+
+        /**
+         * @brief Maps a snapshot file read-only.
+         *
+         * Only the header is validated; call verify() to check the checksums.
+         * @param path Snapshot written by MyContainer<T>::save().
+         * @throws std::runtime_error if the file cannot be mapped or is not a snapshot of T.
+         */
+        explicit MappedMyContainer(const std::string& path)
+            : file(path), header(read_mapped_header(file)),
+              view(elements_of(file, header), permutation_of(file, header)) {}
+
+        MappedMyContainer(const MappedMyContainer&) = delete;
+        MappedMyContainer& operator=(const MappedMyContainer&) = delete;
+
+        /**
+         * @brief Returns the number of elements in the snapshot.
+         */
+        size_t size() const {
+            return static_cast<size_t>(header.count);
+        }
+
+        /**
+         * @brief Returns true if sorted orders use a permutation stored in the file.
+         */
+        bool has_stored_permutation() const {
+            return view.has_stored_permutation();
+        }
+
+        /**
+         * @brief Reads the whole file and checks the payload and permutation checksums.
+         *
+         * @throws std::runtime_error if a checksum does not match.
+         */
+        void verify() const {
+            snapshot::Checksum checksum;
+            checksum.update(view.get_data().data(), header.payload_bytes);
+            if (checksum.value() != header.checksum) {
+                throw std::runtime_error("Snapshot checksum mismatch");
+            }
+            std::span<const uint64_t> stored = permutation_of(file, header);
+            if (!stored.empty()) {
+                snapshot::Checksum permutation_checksum;
+                permutation_checksum.update(stored.data(), stored.size_bytes());
+                uint64_t expected;
+                std::memcpy(&expected, stored.data() - 1, sizeof(expected));
+                if (permutation_checksum.value() != expected) {
+                    throw std::runtime_error("Snapshot checksum mismatch");
+                }
+            }
+        }
+
+        /**
+         * @brief Sorts the mapped elements out of core, under a memory budget.
+         *
+         * Unlike the sorted orders above, needs no permutation in memory, so
+         * it works for snapshots far larger than RAM.
+         * @param memory_budget Bytes of elements held in memory at a time.
+         * @param directory Directory for the temporary run files.
+         */
+        ExternalSort<T> external_sort(size_t memory_budget,
+                                      const std::string& directory = std::filesystem::temp_directory_path().string()) const {
+            return view.external_sort(memory_budget, directory);
+        }
+
+        AscendingOrderIterator begin_ascending_order() const {
+            return view.begin_ascending_order();
+        }
+
+        AscendingOrderIterator end_ascending_order() const {
+            return view.end_ascending_order();
+        }
+
+        DescendingOrderIterator begin_descending_order() const {
+            return view.begin_descending_order();
+        }
+
+        DescendingOrderIterator end_descending_order() const {
+            return view.end_descending_order();
+        }
+
+        SideCrossOrderIterator begin_side_cross_order() const {
+            return view.begin_side_cross_order();
+        }
+
+        SideCrossOrderIterator end_side_cross_order() const {
+            return view.end_side_cross_order();
+        }
+
+        ReverseOrderIterator begin_reverse_order() const {
+            return view.begin_reverse_order();
+        }
+
+        ReverseOrderIterator end_reverse_order() const {
+            return view.end_reverse_order();
+        }
+
+        OrderIterator begin_order() const {
+            return view.begin_order();
+        }
+
+        OrderIterator end_order() const {
+            return view.end_order();
+        }
+
+        MiddleOutOrderIterator begin_middle_out_order() const {
+            return view.begin_middle_out_order();
+        }
+
+        MiddleOutOrderIterator end_middle_out_order() const {
+            return view.end_middle_out_order();
+        }
+    };
+
+}
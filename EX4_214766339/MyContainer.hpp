@@ -1,171 +1,1828 @@
 //fadinujedat062@gmail.com
 #pragma once
 #include <iostream>
+#include <locale>
 #include <vector>
+#include <memory>
+#include <memory_resource>
+#include <span>
 #include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
 #include <stdexcept>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include "WorkStealingPool.hpp"
+#include "KWayMerge.hpp"
+#include "Reductions.hpp"
+#include "Generator.hpp"
+#include "Snapshot.hpp"
+#include "TextFormat.hpp"
+#include "MappedFile.hpp"
+#include "ExternalSort.hpp"
+#include "OperationLog.hpp"
+#include "CompressedSnapshot.hpp"
 
 namespace containers {
+    namespace detail {
+        /**
+         * @brief Position in sorted order of the k-th element of a side-cross traversal.
+         *
+         * Side-cross visits smallest, largest, 2nd smallest, 2nd largest, etc.
+         * @param n Number of elements.
+         * @param k Step of the traversal, k < n.
+         */
+        inline size_t side_cross_index(size_t n, size_t k) {
+            return (k % 2 == 0) ? k / 2 : n - 1 - k / 2;
+        }
+
+        /**
+         * @brief Position in insertion order of the k-th element of a middle-out traversal.
+         *
+         * Middle-out starts at n / 2 and alternates right, left, right, left...
+         * continuing on the remaining side once the other one is exhausted.
+         * @param n Number of elements.
+         * @param k Step of the traversal, k < n.
+         */
+        inline size_t middle_out_index(size_t n, size_t k) {
+            size_t mid = n / 2;
+            size_t right_count = n - 1 - mid;
+            if (k == 0) return mid;
+            if (k > 2 * right_count) return mid - (k - right_count);
+            return (k % 2 == 1) ? mid + (k + 1) / 2 : mid - k / 2;
+        }
+
+        /**
+         * @brief Satisfied by element types ordered with operator<.
+         */
+        template<typename T>
+        concept less_than_comparable = requires(const T& a, const T& b) {
+            { a < b } -> std::convertible_to<bool>;
+        };
+
+        /**
+         * @brief Instrumentation counters, recorded only when MYCONTAINER_STATS is defined.
+         */
+        enum class Stat : size_t { Sorts, ElementsCopied, IteratorBytes, CacheHits, CacheMisses, RemoveScans, ElementsScanned, Count };
+    }
+
+#ifdef MYCONTAINER_STATS
+    /**
+     * @brief Snapshot of the operation counters of one MyContainer, see MyContainer::stats().
+     */
+    struct ContainerStats {
+        uint64_t sorts = 0;///< Sorted orderings built (ascending, descending, side-cross); a background rebuild counts once
+        uint64_t elements_copied = 0;///< Elements copied out of the storage into orderings or container copies
+        uint64_t iterator_bytes_allocated = 0;///< Bytes of ordering buffers allocated for iterators, spans and dumps
+        uint64_t cache_hits = 0;///< Ordering requests served from the cache
+        uint64_t cache_misses = 0;///< Ordering requests that built the ordering
+        uint64_t remove_scans = 0;///< Full passes over the storage made by remove()
+        uint64_t elements_scanned = 0;///< Elements visited by those passes
+    };
+#endif
+
+    /**
+     * @brief A [begin, end) pair of MyContainer iterators over a shared ordering.
+     * 
+     * Usable in range-based for loops and splittable again for fork-join processing.
+     */
+    template<typename Iterator>
+    class IteratorRange {
+    private:
+        Iterator first;
+        Iterator last;
+
+    public:
+        IteratorRange(Iterator first, Iterator last) : first(std::move(first)), last(std::move(last)) {}
+
+        Iterator begin() const { return first; }
+        Iterator end() const { return last; }
+
+        /**
+         * @brief Returns the number of elements in the range.
+         */
+        size_t size() const { return last.position() - first.position(); }
+
+        bool empty() const { return size() == 0; }
+
+        /**
+         * @brief Splits the range into k balanced, disjoint sub-ranges.
+         * 
+         * @param k Number of sub-ranges, at least one.
+         * @throws std::invalid_argument if k is zero.
+         */
+        std::vector<IteratorRange> split(size_t k) const {
+            return first.split(k, last);
+        }
+    };
+
+    /**
+     * @brief Traversal orders supported by MyContainer.
+     */
+    enum class Order {
+        Ascending,///< Smallest to largest
+        Descending,///< Largest to smallest
+        SideCross,///< Smallest, largest, 2nd smallest, 2nd largest, ...
+        Reverse,///< Reverse insertion order
+        Insertion,///< Insertion order
+        MiddleOut///< Middle element, then alternately right and left
+    };
+
+    /**
+     * @brief Execution mode of the built-in reductions and bulk loaders.
+     */
+    enum class Execution {
+        Sequential,///< Run on the calling thread
+        Parallel///< Split blocks across the work-stealing pool
+    };
+
+    /**
+     * @brief Summation order of sum() and mean() for floating-point elements.
+     */
+    enum class Summation {
+        Fast,///< Fastest kernel on this CPU; results may differ between machines in the last bits
+        Deterministic///< One fixed order on every target, so results match bit for bit across machines
+    };
+
     /**
      * @brief A generic container that supports custom iteration orders.
      * 
      * Provides insertion, removal, and multiple ways to iterate
      * over the elements using various strategies (ascending, descending, etc.).
+     *
+     * The element storage is a template parameter. Any vector-like type
+     * exposing get_allocator() can be used, e.g. std::pmr::vector<T> to back
+     * the container and all of its iterator buffers with a memory_resource.
      */
-    template<typename T = int>
+    template<typename T = int, typename Storage = std::vector<T>>
     class MyContainer {
+    public:
+        using value_type = T;
+        using storage_type = Storage;
+        using allocator_type = typename Storage::allocator_type;
+        using ordering_type = std::vector<T, typename std::allocator_traits<allocator_type>::template rebind_alloc<T>>;
+
+    private:
+        using buffer_type = ordering_type;
+
+        Storage data;///< Internal storage for container elements
+
+        /**
+         * @brief Cached orderings, one slot per Order, and the optional background pre-sorting worker.
+         *
+         * A cached ordering is valid while its built version equals the
+         * mutation version. Const readers build stale orderings single-flight:
+         * the first one marks the slot as building and the others wait for it.
+         */
+        struct OrderingCache {
+            static constexpr size_t SLOTS = 6;///< One per Order
+            static constexpr size_t SORTED_SLOTS = 3;///< Ascending, Descending, SideCross
+
+            std::mutex mutex;
+            std::condition_variable changed;
+            std::shared_ptr<const buffer_type> orderings[SLOTS];
+            uint64_t built[SLOTS] = {};///< Version each cached ordering was built from
+            bool building[SLOTS] = {};///< A reader is building this slot
+            uint64_t version = 0;///< Bumped on every mutation
+            uint64_t attempted = 0;///< Last version the worker finished working on
+            bool background = false;
+            bool urgent = false;///< A reader is waiting; skip the settle delay
+            bool stopping = false;
+            std::chrono::milliseconds settle{5};
+            std::thread worker;
+
+            bool fresh(size_t slot) const {
+                return orderings[slot] && built[slot] == version;
+            }
+        };
+
+        mutable OrderingCache cache;
+
+#ifdef MYCONTAINER_STATS
+        mutable std::atomic<uint64_t> counters[static_cast<size_t>(detail::Stat::Count)] = {};
+#endif
+
+        /**
+         * @brief Adds n to an instrumentation counter; compiles to nothing without MYCONTAINER_STATS.
+         */
+        void note([[maybe_unused]] detail::Stat stat, [[maybe_unused]] uint64_t n = 1) const {
+#ifdef MYCONTAINER_STATS
+            counters[static_cast<size_t>(stat)].fetch_add(n, std::memory_order_relaxed);
+#endif
+        }
+
+        /**
+         * @brief Counts one ordering built from the storage.
+         */
+        void note_build(Order order, const buffer_type& ordered) const {
+            if (static_cast<size_t>(order) < OrderingCache::SORTED_SLOTS) {
+                note(detail::Stat::Sorts);
+            }
+            note(detail::Stat::ElementsCopied, data.size());
+            note(detail::Stat::IteratorBytes, ordered.capacity() * sizeof(T));
+        }
+
+        using LogOp = typename detail::OperationLog<T>::Op;
+
+        /**
+         * @brief Files and log of a persistent container.
+         *
+         * Generation G consists of snapshot.G (absent for G = 0) and log.G,
+         * which holds the mutations made after snapshot.G was written. While a
+         * periodic checkpoint is being written in the background, appends
+         * already go to log.G+1 and snapshot.G, log.G, log.G+1 recover the state.
+         */
+        struct Persistence {
+            std::string directory;
+            uint64_t generation = 0;
+            size_t checkpoint_every = 0;
+            std::unique_ptr<detail::OperationLog<T>> log;
+            std::thread checkpointer;///< Writes the pending periodic snapshot, if any
+            std::exception_ptr checkpoint_error;///< Set by a failed background checkpoint
+
+            ~Persistence() {
+                if (checkpointer.joinable()) checkpointer.join();
+            }
+        };
+
+        std::unique_ptr<Persistence> persistence;
+
+        static std::string snapshot_path(const std::string& directory, uint64_t generation) {
+            return (std::filesystem::path(directory) / ("snapshot." + std::to_string(generation))).string();
+        }
+
+        static std::string log_path(const std::string& directory, uint64_t generation) {
+            return (std::filesystem::path(directory) / ("log." + std::to_string(generation))).string();
+        }
+
+        /**
+         * @brief Reads the generation out of a file name of the form prefix + digits.
+         */
+        static bool parse_generation(const std::string& name, const std::string& prefix, uint64_t& generation) {
+            if (name.size() <= prefix.size() || name.rfind(prefix, 0) != 0 ||
+                name.find_first_not_of("0123456789", prefix.size()) != std::string::npos) {
+                return false;
+            }
+            generation = std::stoull(name.substr(prefix.size()));
+            return true;
+        }
+
+        /**
+         * @brief Deletes the snapshots and logs of generations before keep, and leftover temporary snapshots.
+         */
+        static void remove_generations_before(const std::string& directory, uint64_t keep) {
+            std::vector<std::filesystem::path> stale;
+            for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+                std::string name = entry.path().filename().string();
+                uint64_t g;
+                if (((parse_generation(name, "snapshot.", g) || parse_generation(name, "log.", g)) && g < keep) ||
+                    (name.rfind("snapshot.", 0) == 0 && name.size() > 4 && name.compare(name.size() - 4, 4, ".tmp") == 0)) {
+                    stale.push_back(entry.path());
+                }
+            }
+            for (const auto& path : stale) {
+                std::filesystem::remove(path);
+            }
+        }
+
+        /**
+         * @brief Waits for the background checkpoint of p, if any, and rethrows its error.
+         */
+        static void join_checkpoint(Persistence& p) {
+            if (p.checkpointer.joinable()) {
+                p.checkpointer.join();
+            }
+            if (p.checkpoint_error) {
+                std::rethrow_exception(std::exchange(p.checkpoint_error, nullptr));
+            }
+        }
+
+        /**
+         * @brief Applies fn through mutate(), logging it first on a persistent container.
+         *
+         * The record is written before the mutation so a failed write leaves the
+         * contents untouched, and taken back if the mutation throws, so the log
+         * only ever holds mutations that happened.
+         */
+        template<typename Fn>
+        void logged(LogOp op, const T& value, Fn&& fn) {
+            if constexpr (snapshot::is_supported_v<T>) {
+                if (persistence) {
+                    persistence->log->append(op, value);
+                    try {
+                        mutate(std::forward<Fn>(fn));
+                    } catch (...) {
+                        try {
+                            persistence->log->undo_last();
+                        } catch (...) {
+                        }
+                        throw;
+                    }
+                    return;
+                }
+            }
+            mutate(std::forward<Fn>(fn));
+        }
+
+        /**
+         * @brief Starts a background checkpoint once the log holds checkpoint_every records.
+         *
+         * The mutation path only copies the contents in memory and switches to
+         * the next log; writing and syncing the snapshot happen on a worker
+         * thread. If the previous checkpoint is still running, it is waited for.
+         */
+        void maybe_checkpoint() {
+            if constexpr (snapshot::is_supported_v<T>) {
+                if (persistence && persistence->checkpoint_every != 0 &&
+                    persistence->log->size() >= persistence->checkpoint_every) {
+                    Persistence& p = *persistence;
+                    join_checkpoint(p);
+                    const uint64_t next = p.generation + 1;
+                    std::filesystem::remove(log_path(p.directory, next));
+                    p.log = std::make_unique<detail::OperationLog<T>>(log_path(p.directory, next));
+                    p.generation = next;
+                    p.checkpointer = std::thread([&p, next, directory = p.directory, contents = Storage(data)]() mutable {
+                        try {
+                            const MyContainer copy(std::move(contents));
+                            const std::string target = snapshot_path(directory, next);
+                            copy.save(target + ".tmp");
+                            sync_path(target + ".tmp");
+                            std::filesystem::rename(target + ".tmp", target);
+                            sync_path(directory);
+                            remove_generations_before(directory, next);
+                        } catch (...) {
+                            p.checkpoint_error = std::current_exception();
+                        }
+                    });
+                }
+            }
+        }
+
+        /**
+         * @brief Checkpoints a persistent container after its contents were replaced wholesale.
+         */
+        void checkpoint_if_persistent() {
+            if constexpr (snapshot::is_supported_v<T>) {
+                if (persistence) {
+                    checkpoint();
+                }
+            }
+        }
+
+        /**
+         * @brief Returns the indices of the elements in stable ascending order.
+         *
+         * Instantiates operator< only for element types that have one, so
+         * save() and the checkpoints it backs work for any snapshot type.
+         * @throws std::invalid_argument if T has no operator<.
+         */
+        std::vector<uint64_t> ascending_permutation() const {
+            if constexpr (detail::less_than_comparable<T>) {
+                std::vector<uint64_t> permutation(data.size());
+                for (size_t i = 0; i < permutation.size(); ++i) permutation[i] = i;
+                std::stable_sort(permutation.begin(), permutation.end(),
+                                 [this](uint64_t a, uint64_t b) { return data[a] < data[b]; });
+                return permutation;
+            } else {
+                throw std::invalid_argument("Ascending permutation needs elements with operator<");
+            }
+        }
+
+        static void sync_path(const std::string& path) {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd >= 0) {
+                ::fsync(fd);
+                ::close(fd);
+            }
+        }
+
+        /**
+         * @brief Applies a mutation to the storage and invalidates the cached orderings.
+         *
+         * Holds the cache lock while the background worker runs, so the worker
+         * never copies the storage mid-mutation.
+         */
+        template<typename Fn>
+        void mutate(Fn&& fn) {
+            if (!cache.background) {
+                fn();
+                invalidate();
+                return;
+            }
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            fn();
+            bool idle = cache.attempted == cache.version;
+            invalidate();
+            if (idle) {
+                cache.changed.notify_all();
+            }
+        }
+
+        void invalidate() {
+            ++cache.version;
+            for (auto& ordering : cache.orderings) {
+                ordering.reset();
+            }
+        }
+
+        /**
+         * @brief Stops the background worker, if any, and returns the storage.
+         */
+        Storage& quiesce() {
+            disable_background_presort();
+            return data;
+        }
+
+        /**
+         * @brief Wraps a built ordering into a shared buffer allocated with the storage allocator.
+         */
+        static std::shared_ptr<const buffer_type> share(buffer_type&& ordered) {
+            typename buffer_type::allocator_type alloc = ordered.get_allocator();
+            return std::allocate_shared<buffer_type>(alloc, std::move(ordered));
+        }
+
+        /**
+         * @brief Returns the cached ordering for the given order, building it if stale.
+         *
+         * Single-flight: concurrent callers on an unchanged container share one
+         * build. The first caller builds outside the lock while the others wait
+         * for it; if the build throws, the next waiter retries. With the
+         * background worker enabled, a caller that finds a sorted ordering
+         * stale wakes the worker and waits for its result instead. The order
+         * is a template parameter, so unsorted orders never instantiate the
+         * comparisons and work for element types without operator<.
+         */
+        template<Order order>
+        std::shared_ptr<const buffer_type> cached_ordering() const {
+            const size_t slot = static_cast<size_t>(order);
+            std::unique_lock<std::mutex> lock(cache.mutex);
+            if (cache.background && slot < OrderingCache::SORTED_SLOTS && !cache.fresh(slot)) {
+                cache.urgent = true;
+                cache.changed.notify_all();
+                cache.changed.wait(lock, [&] { return cache.fresh(slot) || cache.attempted == cache.version; });
+            }
+            cache.changed.wait(lock, [&] { return cache.fresh(slot) || !cache.building[slot]; });
+            if (cache.fresh(slot)) {
+                note(detail::Stat::CacheHits);
+                return cache.orderings[slot];
+            }
+            note(detail::Stat::CacheMisses);
+            const uint64_t version = cache.version;
+            cache.building[slot] = true;
+            lock.unlock();
+            std::shared_ptr<const buffer_type> ordered;
+            try {
+                buffer_type built = build_ordering<order>(data);
+                note_build(order, built);
+                ordered = share(std::move(built));
+            } catch (...) {
+                lock.lock();
+                cache.building[slot] = false;
+                cache.changed.notify_all();
+                throw;
+            }
+            lock.lock();
+            cache.building[slot] = false;
+            if (cache.version == version) {
+                cache.orderings[slot] = ordered;
+                cache.built[slot] = version;
+            }
+            cache.changed.notify_all();
+            return ordered;
+        }
+
+        /**
+         * @brief Runtime-dispatched cached_ordering(); instantiates every order.
+         */
+        std::shared_ptr<const buffer_type> cached_ordering(Order order) const {
+            switch (order) {
+                case Order::Ascending: return cached_ordering<Order::Ascending>();
+                case Order::Descending: return cached_ordering<Order::Descending>();
+                case Order::SideCross: return cached_ordering<Order::SideCross>();
+                case Order::Reverse: return cached_ordering<Order::Reverse>();
+                case Order::Insertion: return cached_ordering<Order::Insertion>();
+                case Order::MiddleOut: return cached_ordering<Order::MiddleOut>();
+            }
+            throw std::invalid_argument("Unknown traversal order");
+        }
+
+        /**
+         * @brief Body of the background worker.
+         *
+         * Waits for a mutation, then for the mutations to settle (no change for
+         * the settle delay, or a waiting reader), copies the storage under the
+         * lock, sorts once outside the lock, derives the descending and
+         * side-cross orderings from the sorted copy and publishes all three
+         * unless the container changed meanwhile.
+         */
+        void presort_loop() {
+            std::unique_lock<std::mutex> lock(cache.mutex);
+            while (true) {
+                cache.changed.wait(lock, [this] { return cache.stopping || cache.attempted != cache.version; });
+                uint64_t seen = cache.version;
+                while (!cache.stopping && !cache.urgent) {
+                    cache.changed.wait_for(lock, cache.settle, [this] { return cache.stopping || cache.urgent; });
+                    if (cache.version == seen) break;
+                    seen = cache.version;
+                }
+                if (cache.stopping) return;
+                cache.urgent = false;
+
+                const uint64_t version = cache.version;
+                std::shared_ptr<const buffer_type> built[OrderingCache::SORTED_SLOTS];
+                try {
+                    buffer_type ascending(data.begin(), data.end(), data.get_allocator());
+                    lock.unlock();
+                    std::sort(ascending.begin(), ascending.end());
+                    buffer_type descending(ascending.rbegin(), ascending.rend(), ascending.get_allocator());
+                    buffer_type crossed(ascending.get_allocator());
+                    crossed.reserve(ascending.size());
+                    for (size_t k = 0; k < ascending.size(); ++k) {
+                        crossed.push_back(ascending[detail::side_cross_index(ascending.size(), k)]);
+                    }
+                    note(detail::Stat::Sorts);
+                    note(detail::Stat::ElementsCopied, ascending.size());
+                    note(detail::Stat::IteratorBytes,
+                         (ascending.capacity() + descending.capacity() + crossed.capacity()) * sizeof(T));
+                    built[static_cast<size_t>(Order::Ascending)] = share(std::move(ascending));
+                    built[static_cast<size_t>(Order::Descending)] = share(std::move(descending));
+                    built[static_cast<size_t>(Order::SideCross)] = share(std::move(crossed));
+                } catch (...) {
+                    // Readers fall back to building the ordering themselves.
+                }
+                if (!lock.owns_lock()) lock.lock();
+                if (cache.version == version && built[0]) {
+                    for (size_t slot = 0; slot < OrderingCache::SORTED_SLOTS; ++slot) {
+                        // A fresh slot may already be exported through ordered_span(); keep it.
+                        if (cache.fresh(slot)) continue;
+                        cache.orderings[slot] = std::move(built[slot]);
+                        cache.built[slot] = version;
+                    }
+                }
+                cache.attempted = version;
+                cache.changed.notify_all();
+            }
+        }
+
+        /**
+         * @brief Materializes the elements of source in the given traversal order.
+         *
+         * The buffer is allocated with the storage allocator. Only the sorted
+         * orders instantiate operator< on T.
+         * @tparam order Traversal order to build.
+         * @param source Elements in insertion order.
+         * @return buffer_type Elements in traversal order.
+         */
+        template<Order order>
+        static buffer_type build_ordering(const Storage& source) {
+            buffer_type ordered(source.begin(), source.end(), source.get_allocator());
+            if constexpr (order == Order::Ascending) {
+                std::sort(ordered.begin(), ordered.end());
+            } else if constexpr (order == Order::Descending) {
+                std::sort(ordered.begin(), ordered.end(), std::greater<T>());
+            } else if constexpr (order == Order::SideCross) {
+                std::sort(ordered.begin(), ordered.end());
+                buffer_type crossed(source.get_allocator());
+                crossed.reserve(ordered.size());
+                for (size_t k = 0; k < ordered.size(); ++k) {
+                    crossed.push_back(ordered[detail::side_cross_index(ordered.size(), k)]);
+                }
+                ordered.swap(crossed);
+            } else if constexpr (order == Order::Reverse) {
+                std::reverse(ordered.begin(), ordered.end());
+            } else if constexpr (order == Order::MiddleOut) {
+                buffer_type middle_out(source.get_allocator());
+                middle_out.reserve(ordered.size());
+                for (size_t k = 0; k < ordered.size(); ++k) {
+                    middle_out.push_back(ordered[detail::middle_out_index(ordered.size(), k)]);
+                }
+                ordered.swap(middle_out);
+            }
+            return ordered;
+        }
+
+        /**
+         * @brief Base class for all iterators in MyContainer.
+         * 
+         * Holds a shared, immutable copy of the ordered data and a traversal index.
+         * Copies of an iterator share the ordering, so copying and splitting never
+         * rebuild it. The ordering is allocated with the container's allocator.
+         * Provides common operator implementations for all derived iterators.
+         */
+        template<typename IterType, typename Derived>
+        class BaseIterator {
+        protected:
+            using buffer_allocator = typename std::allocator_traits<allocator_type>::template rebind_alloc<IterType>;
+            using ordered_buffer = std::vector<IterType, buffer_allocator>;
+
+            std::shared_ptr<const ordered_buffer> ordered_data;
+            size_t index = 0;
+
+        public:
+            /**
+             * @brief Default constructor.
+             */
+            BaseIterator() = default;
+
+            /**
+             * @brief Constructs an iterator over an already ordered buffer.
+             *
+             * The buffer and its control block are allocated with the buffer's allocator.
+             * @param ordered Elements in traversal order.
+             * @param begin If true, starts from index 0; otherwise from end.
+             */
+            BaseIterator(ordered_buffer&& ordered, bool begin) {
+                buffer_allocator alloc = ordered.get_allocator();
+                ordered_data = std::allocate_shared<ordered_buffer>(alloc, std::move(ordered));
+                index = begin ? 0 : ordered_data->size();
+            }
+
+            /**
+             * @brief Constructs an iterator over a shared, already ordered buffer.
+             *
+             * @param ordered Elements in traversal order, shared with other iterators.
+             * @param begin If true, starts from index 0; otherwise from end.
+             */
+            BaseIterator(std::shared_ptr<const ordered_buffer> ordered, bool begin)
+                : ordered_data(std::move(ordered)) {
+                index = begin ? 0 : ordered_data->size();
+            }
+
+            /**
+             * @brief Copy constructor. Shares the ordering.
+             */
+            BaseIterator(const BaseIterator& other) = default;
+
+             /**
+             * @brief Dereference operator.
+             * 
+             * @return const IterType& Reference to the current element.
+             * @throws std::out_of_range if attempting to dereference end().
+             */
+            const IterType& operator*() const {
+                if (!ordered_data || index >= ordered_data->size()) {
+                    throw std::out_of_range("Dereferencing end() iterator");
+                }
+                return (*ordered_data)[index];
+            }
+            /**
+             * @brief Prefix increment operator.
+             * 
+             * Advances the iterator to the next element.
+             * @return Derived& Reference to the updated iterator.
+             */
+            Derived& operator++() {
+                ++index;
+                return static_cast<Derived&>(*this);
+            }
+
+            /**
+             * @brief Inequality comparison operator.
+             * 
+             * @param other Another iterator to compare with.
+             * @return true if iterators point to different positions.
+             */
+            bool operator!=(const BaseIterator& other) const {
+                return !(*this == other);
+            }
+
+             /**
+             * @brief Equality comparison operator.
+             * 
+             * An iterator without an ordering (see AscendingOrderIterator::end_of())
+             * is a sentinel equal to any iterator at or past the end of its own ordering.
+             * @param other Another iterator to compare with.
+             * @return true if iterators point to the same position.
+             */
+            bool operator==(const BaseIterator& other) const {
+                if (ordered_data && !other.ordered_data) return index >= ordered_data->size();
+                if (!ordered_data && other.ordered_data) return other.index >= other.ordered_data->size();
+                return index == other.index;
+            }
+
+            /**
+             * @brief Assignment operator.
+             * 
+             * @param other Iterator to assign from.
+             * @return BaseIterator& Reference to this.
+             */
+            BaseIterator& operator=(const BaseIterator& other) {
+                if (this != &other) {
+                    this->ordered_data = other.ordered_data;
+                    this->index = other.index;
+                }
+                return *this;
+            }
+
+             /**
+             * @brief Returns the current position within the ordered data.
+             * 
+             * @return size_t Index of the iterator.
+             */
+            size_t position() const {
+                return index;
+            }
+
+            /**
+             * @brief Splits the traversal from this position up to last into k balanced sub-ranges.
+             * 
+             * The sub-ranges are disjoint, cover [position(), last.position()) in order,
+             * differ in length by at most one and share this iterator's ordering.
+             * @param k Number of sub-ranges, at least one.
+             * @param last End of the traversal to split.
+             * @return std::vector<IteratorRange<Derived>> Exactly k ranges, possibly empty.
+             * @throws std::invalid_argument if k is zero.
+             */
+            std::vector<IteratorRange<Derived>> split(size_t k, const Derived& last) const {
+                if (k == 0) {
+                    throw std::invalid_argument("Cannot split into zero ranges");
+                }
+                size_t lo = index;
+                size_t hi = std::max(lo, last.index);
+                size_t length = hi - lo;
+                std::vector<IteratorRange<Derived>> ranges;
+                ranges.reserve(k);
+                size_t start = lo;
+                for (size_t i = 0; i < k; ++i) {
+                    size_t stop = start + length / k + (i < length % k ? 1 : 0);
+                    ranges.emplace_back(at(start), at(stop));
+                    start = stop;
+                }
+                return ranges;
+            }
+
+            /**
+             * @brief Splits the remaining traversal, from this position to the end, into k balanced sub-ranges.
+             * 
+             * @param k Number of sub-ranges, at least one.
+             * @return std::vector<IteratorRange<Derived>> Exactly k ranges, possibly empty.
+             * @throws std::invalid_argument if k is zero.
+             */
+            std::vector<IteratorRange<Derived>> split(size_t k) const {
+                return split(k, at(ordered_data ? ordered_data->size() : index));
+            }
+
+        private:
+            /**
+             * @brief Returns a copy of this iterator moved to the given position.
+             */
+            Derived at(size_t position) const {
+                Derived copy = static_cast<const Derived&>(*this);
+                copy.index = position;
+                return copy;
+            }
+        };
+
+    public:
+        /**
+         * @brief Default constructor.
+         */
+        MyContainer() = default;
+
+        /**
+         * @brief Constructs an empty container that allocates through the given allocator.
+         *
+         * With std::pmr::vector storage a std::pmr::memory_resource* converts
+         * implicitly, so the container can be placed in an arena directly.
+         * @param alloc Allocator used for the storage and every iterator buffer.
+         */
+        explicit MyContainer(const allocator_type& alloc) : data(alloc) {}
+
+        /**
+         * @brief Adopts an existing storage by move, without copying its elements.
+         *
+         * @param storage Elements that become the contents, in insertion order.
+         */
+        explicit MyContainer(Storage&& storage) noexcept : data(std::move(storage)) {}
+
+        /**
+         * @brief Copy constructor. The copy starts with a cold cache and no background worker.
+         */
+        MyContainer(const MyContainer& other) : data(other.data) {
+            other.note(detail::Stat::ElementsCopied, other.data.size());
+        }
+
+        /**
+         * @brief Move constructor. Stops other's background worker; the new
+         * container starts with a cold cache and no background worker.
+         */
+        MyContainer(MyContainer&& other) noexcept
+            : data(std::move(other.quiesce())), persistence(std::move(other.persistence)) {
+            other.invalidate();
+        }
+
+        /**
+         * @brief Copy assignment. Keeps this container's background and persistence
+         * settings; a persistent container checkpoints its new contents.
+         */
+        MyContainer& operator=(const MyContainer& other) {
+            if (this != &other) {
+                other.note(detail::Stat::ElementsCopied, other.data.size());
+                mutate([&] { data = other.data; });
+                checkpoint_if_persistent();
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Move assignment. Stops other's background worker and detaches
+         * its persistence; keeps this container's settings.
+         */
+        MyContainer& operator=(MyContainer&& other) {
+            if (this != &other) {
+                Storage& source = other.quiesce();
+                mutate([&] { data = std::move(source); });
+                other.invalidate();
+                other.persistence.reset();
+                checkpoint_if_persistent();
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destructor. Joins the background worker, if any.
+         */
+        ~MyContainer() {
+            disable_background_presort();
+        }
+
+        /**
+         * @brief Starts a background worker that pre-sorts after mutations settle.
+         *
+         * Once no mutation happened for the settle delay, the worker rebuilds
+         * the ascending, descending and side-cross orderings off the calling
+         * thread and publishes them, so the next begin_*_order() call finds
+         * them ready. A reader arriving while the rebuild is pending wakes the
+         * worker and waits for it instead of sorting itself. While enabled,
+         * addElement and remove take a lock. The allocator must be usable from
+         * the worker thread. Calling it again only updates the settle delay.
+         * @param settle Quiet period after the last mutation before rebuilding.
+         */
+        void enable_background_presort(std::chrono::milliseconds settle = std::chrono::milliseconds(5)) {
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            cache.settle = settle;
+            if (cache.background) return;
+            cache.background = true;
+            cache.stopping = false;
+            cache.worker = std::thread([this] { presort_loop(); });
+        }
+
+        /**
+         * @brief Stops and joins the background worker. Cached orderings stay valid.
+         */
+        void disable_background_presort() {
+            if (!cache.background) return;
+            {
+                std::lock_guard<std::mutex> lock(cache.mutex);
+                cache.stopping = true;
+            }
+            cache.changed.notify_all();
+            cache.worker.join();
+            cache.background = false;
+            cache.urgent = false;
+            cache.attempted = cache.version;
+        }
+
+        /**
+         * @brief Returns true if the background pre-sorting worker is running.
+         */
+        bool background_presort_enabled() const {
+            return cache.background;
+        }
+
+        /**
+         * @brief Returns true if the ordering is cached for the current contents.
+         *
+         * @param order Traversal order to check.
+         */
+        bool has_cached_ordering(Order order) const {
+            const size_t slot = static_cast<size_t>(order);
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            return cache.fresh(slot);
+        }
+
+#ifdef MYCONTAINER_STATS
+        /**
+         * @brief Returns the operation counters accumulated since construction or reset_stats().
+         *
+         * Only available when MYCONTAINER_STATS is defined; otherwise no
+         * counters exist and the hooks compile to nothing. Every cache miss on
+         * a sorted order is a sort, so a miss count close to the number of
+         * begin_*()/end_*() calls reveals code that mutates between them.
+         */
+        ContainerStats stats() const {
+            auto get = [this](detail::Stat stat) {
+                return counters[static_cast<size_t>(stat)].load(std::memory_order_relaxed);
+            };
+            ContainerStats result;
+            result.sorts = get(detail::Stat::Sorts);
+            result.elements_copied = get(detail::Stat::ElementsCopied);
+            result.iterator_bytes_allocated = get(detail::Stat::IteratorBytes);
+            result.cache_hits = get(detail::Stat::CacheHits);
+            result.cache_misses = get(detail::Stat::CacheMisses);
+            result.remove_scans = get(detail::Stat::RemoveScans);
+            result.elements_scanned = get(detail::Stat::ElementsScanned);
+            return result;
+        }
+
+        /**
+         * @brief Zeroes the operation counters.
+         */
+        void reset_stats() {
+            for (auto& counter : counters) {
+                counter.store(0, std::memory_order_relaxed);
+            }
+        }
+#endif
+
+        /**
+         * @brief Returns the allocator used by the container.
+         *
+         * @return allocator_type Copy of the storage allocator.
+         */
+        allocator_type get_allocator() const {
+            return data.get_allocator();
+        }
+
+        /**
+         * @brief Adds a new element to the container.
+         * 
+         * @param value The element to insert.
+         */
+        void addElement(const T& value) {
+            logged(LogOp::Add, value, [&] { data.push_back(value); });
+            maybe_checkpoint();
+        }
+
+        /**
+         * @brief Removes all occurrences of a given value from the container.
+         * 
+         * @param value The value to remove.
+         * @throws std::runtime_error if the value is not found.
+         */
+        void remove(const T& value) {
+            if (persistence) {
+                note(detail::Stat::RemoveScans);
+                note(detail::Stat::ElementsScanned, data.size());
+                if (std::find(data.begin(), data.end(), value) == data.end()) {
+                    throw std::runtime_error("Item not found in container");
+                }
+            }
+            note(detail::Stat::RemoveScans);
+            note(detail::Stat::ElementsScanned, data.size());
+            logged(LogOp::Remove, value, [&] {
+                auto it = std::remove(data.begin(), data.end(), value);
+                if (it == data.end()) {
+                    throw std::runtime_error("Item not found in container");
+                }
+                data.erase(it, data.end());
+            });
+            maybe_checkpoint();
+        }
+
+        /**
+         * @brief Pre-allocates room for n elements.
+         * 
+         * @param n Expected number of elements.
+         */
+        void reserve(size_t n) {
+            if (!cache.background) {
+                data.reserve(n);
+                return;
+            }
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            data.reserve(n);
+        }
+
+        /**
+         * @brief Returns the number of elements in the container.
+         * 
+         * @return size_t Current size of the container.
+         */
+        size_t size() const {
+            return data.size();
+        }
+
     private:
-        std::vector<T> data;///< Internal storage for container elements
+        /**
+         * @brief Formats elements through a buffered writer.
+         */
+        template<typename Sink, typename Elements>
+        static void write_elements(Sink sink, const Elements& elements, const OutputFormat& format) {
+            detail::TextWriter<Sink> writer(sink);
+            writer.append(format.prefix);
+            for (size_t i = 0; i < elements.size(); ++i) {
+                if (i != 0) writer.append(format.separator);
+                writer.value(elements[i], format.precision);
+            }
+            writer.append(format.suffix);
+            writer.flush();
+        }
+
+        /**
+         * @brief Formats the elements in the given order through a buffered writer.
+         *
+         * Insertion order is read straight from the storage; other orders use the cached ordering.
+         */
+        template<typename Sink>
+        void write_ordered(Sink sink, Order order, const OutputFormat& format) const {
+            if (order == Order::Insertion) {
+                write_elements(sink, data, format);
+            } else {
+                write_elements(sink, *cached_ordering(order), format);
+            }
+        }
+
+    public:
+        /**
+         * @brief Writes the elements in the given order to a stream.
+         * 
+         * Numbers are formatted with std::to_chars into a large reusable
+         * buffer that is handed to the stream in big writes.
+         * @param os Output stream.
+         * @param order Traversal order to write.
+         * @param format Prefix, separator, suffix and floating-point precision.
+         */
+        void write_to(std::ostream& os, Order order = Order::Insertion, const OutputFormat& format = OutputFormat()) const {
+            write_ordered(detail::StreamSink{os}, order, format);
+        }
+
+        /**
+         * @brief Writes the elements in the given order to a POSIX file descriptor.
+         * 
+         * @param fd Open file descriptor, e.g. STDOUT_FILENO.
+         * @param order Traversal order to write.
+         * @param format Prefix, separator, suffix and floating-point precision.
+         * @throws std::runtime_error if a write fails.
+         */
+        void write_to(int fd, Order order = Order::Insertion, const OutputFormat& format = OutputFormat()) const {
+            write_ordered(detail::FdSink{fd}, order, format);
+        }
+
+        /**
+         * @brief Stream insertion operator.
+         * 
+         * Outputs the contents of the container in standard format. A stream
+         * in its default state (flags, width and classic locale) takes the
+         * buffered std::to_chars path with the stream's precision; otherwise
+         * every element goes through the stream, so manipulators such as
+         * std::fixed, std::hex or std::boolalpha apply.
+         * @param os Output stream.
+         * @param container The container to print.
+         * @return std::ostream& The output stream.
+         */
+        friend std::ostream& operator<<(std::ostream& os, const MyContainer& container) {
+            const auto defaults = std::ios_base::dec | std::ios_base::skipws;
+            if (os.flags() != defaults || os.width() != 0 || os.getloc() != std::locale::classic()) {
+                os << "[";
+                for (size_t i = 0; i < container.data.size(); ++i) {
+                    os << container.data[i];
+                    if (i + 1 != container.data.size()) os << ", ";
+                }
+                os << "]";
+                return os;
+            }
+            OutputFormat format;
+            format.precision = static_cast<int>(os.precision());
+            write_elements(detail::StreamSink{os}, container.data, format);
+            return os;
+        }
+
+        /**
+         * @brief Builds a container from numbers in a text buffer.
+         * 
+         * Numbers are separated by the delimiter and/or whitespace and parsed
+         * with std::from_chars in one pass into storage pre-sized from the
+         * estimated count. In parallel mode the buffer is cut at separators
+         * into chunks that are parsed on the work-stealing pool and appended
+         * in order.
+         * @param text Numbers, e.g. one per line or comma-separated.
+         * @param delimiter Field separator in addition to whitespace.
+         * @param exec Sequential or Parallel parsing.
+         * @param alloc Allocator of the new container.
+         * @return MyContainer Elements in text order.
+         * @throws std::runtime_error at the first token that is not a number of type T.
+         */
+        static MyContainer parse_from_buffer(std::string_view text, char delimiter = '\n',
+                                             Execution exec = Execution::Sequential,
+                                             const allocator_type& alloc = allocator_type()) {
+            static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "parse_from needs a numeric element type");
+            MyContainer result(alloc);
+            WorkStealingPool& pool = WorkStealingPool::instance();
+            const size_t chunks = exec == Execution::Parallel ? std::min(pool.size() * 4, text.size() / detail::PARSE_CHUNK + 1) : 1;
+            if (chunks <= 1) {
+                result.data.reserve(detail::estimate_count(text, delimiter));
+                detail::parse_numbers<T>(text.data(), text.data() + text.size(), delimiter, 0,
+                                         [&](const T& value) { result.data.push_back(value); });
+                return result;
+            }
+            std::vector<size_t> bounds = detail::chunk_bounds(text, chunks, delimiter);
+            std::vector<std::vector<T>> parts(chunks);
+            pool.parallel_for(0, chunks, 1, [&](size_t lo, size_t hi) {
+                for (size_t c = lo; c < hi; ++c) {
+                    std::string_view piece = text.substr(bounds[c], bounds[c + 1] - bounds[c]);
+                    parts[c].reserve(detail::estimate_count(piece, delimiter));
+                    detail::parse_numbers<T>(piece.data(), piece.data() + piece.size(), delimiter, bounds[c],
+                                             [&](const T& value) { parts[c].push_back(value); });
+                }
+            });
+            size_t total = 0;
+            for (const auto& part : parts) total += part.size();
+            result.data.reserve(total);
+            for (const auto& part : parts) {
+                for (const T& value : part) result.data.push_back(value);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Builds a container from numbers in a text file.
+         * 
+         * The file is memory-mapped and parsed in place, see parse_from_buffer().
+         * @param path Text file, e.g. one number per line or a CSV row.
+         * @param delimiter Field separator in addition to whitespace.
+         * @param exec Sequential or Parallel parsing.
+         * @param alloc Allocator of the new container.
+         * @return MyContainer Elements in file order.
+         * @throws std::runtime_error if the file cannot be read or holds an invalid number.
+         */
+        static MyContainer parse_from(const std::string& path, char delimiter = '\n',
+                                      Execution exec = Execution::Sequential,
+                                      const allocator_type& alloc = allocator_type()) {
+            detail::MappedFile file(path, true);
+            return parse_from_buffer(file.view(), delimiter, exec, alloc);
+        }
+
+        /**
+         * @brief Builds a container from numbers in a text buffer and sorts it while parsing.
+         * 
+         * The calling thread parses the buffer front to back in chunks and
+         * hands every finished chunk to a sort task on the work-stealing pool,
+         * so sorting overlaps parsing. A parallel k-way merge of the sorted
+         * chunks then fills the ascending ordering cache, and the first
+         * begin_ascending_order() call after loading sorts nothing.
+         * @param text Numbers, e.g. one per line or comma-separated.
+         * @param delimiter Field separator in addition to whitespace.
+         * @param alloc Allocator of the new container.
+         * @return MyContainer Elements in text order, ascending ordering cached.
+         * @throws std::runtime_error at the first token that is not a number of type T.
+         */
+        static MyContainer parse_sorted_from_buffer(std::string_view text, char delimiter = '\n',
+                                                    const allocator_type& alloc = allocator_type()) {
+            static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "parse_from needs a numeric element type");
+            WorkStealingPool& pool = WorkStealingPool::instance();
+            const size_t chunks = text.size() / detail::PARSE_CHUNK + 1;
+            std::vector<size_t> bounds = detail::chunk_bounds(text, chunks, delimiter);
+            std::vector<std::vector<T>> parts(chunks);
+            std::vector<std::vector<T>> runs(chunks);
+            {
+                WorkStealingPool::TaskGroup sorters(pool);
+                for (size_t c = 0; c < chunks; ++c) {
+                    std::string_view piece = text.substr(bounds[c], bounds[c + 1] - bounds[c]);
+                    parts[c].reserve(detail::estimate_count(piece, delimiter));
+                    detail::parse_numbers<T>(piece.data(), piece.data() + piece.size(), delimiter, bounds[c],
+                                             [&](const T& value) { parts[c].push_back(value); });
+                    sorters.run([&parts, &runs, c] {
+                        runs[c] = parts[c];
+                        std::sort(runs[c].begin(), runs[c].end());
+                    });
+                }
+                sorters.wait();
+            }
+            MyContainer result(alloc);
+            size_t total = 0;
+            for (const auto& part : parts) total += part.size();
+            result.data.reserve(total);
+            for (auto& part : parts) {
+                for (const T& value : part) result.data.push_back(value);
+                std::vector<T>().swap(part);
+            }
+            std::vector<SortedRun<T>> sorted;
+            for (const auto& run : runs) {
+                sorted.emplace_back(run.data(), run.data() + run.size());
+            }
+            buffer_type ascending(result.data.get_allocator());
+            parallel_multiway_merge(sorted, ascending, pool);
+            const size_t slot = static_cast<size_t>(Order::Ascending);
+            result.note_build(Order::Ascending, ascending);
+            result.cache.orderings[slot] = share(std::move(ascending));
+            result.cache.built[slot] = result.cache.version;
+            return result;
+        }
+
+        /**
+         * @brief Builds a container from numbers in a text file and sorts it while parsing.
+         * 
+         * The file is memory-mapped for sequential reading and parsed in
+         * place, see parse_sorted_from_buffer().
+         * @param path Text file, e.g. one number per line or a CSV row.
+         * @param delimiter Field separator in addition to whitespace.
+         * @param alloc Allocator of the new container.
+         * @return MyContainer Elements in file order, ascending ordering cached.
+         * @throws std::runtime_error if the file cannot be read or holds an invalid number.
+         */
+        static MyContainer parse_sorted_from(const std::string& path, char delimiter = '\n',
+                                             const allocator_type& alloc = allocator_type()) {
+            detail::MappedFile file(path, true);
+            return parse_sorted_from_buffer(file.view(), delimiter, alloc);
+        }
+
+        /**
+         * @brief Sorts the elements out of core, under a memory budget.
+         * 
+         * For containers whose sorted copy does not fit in memory: sorted runs
+         * of at most memory_budget bytes are spilled to temporary files and
+         * the ascending and descending traversals of the result stream a
+         * k-way merge over them.
+         * @param memory_budget Bytes of elements held in memory at a time.
+         * @param directory Directory for the temporary run files.
+         * @return ExternalSort<T> Sorter providing begin/end_ascending_order() and begin/end_descending_order().
+         */
+        ExternalSort<T> external_sort(size_t memory_budget,
+                                      const std::string& directory = std::filesystem::temp_directory_path().string()) const {
+            return ExternalSort<T>(data.begin(), data.end(), memory_budget, directory);
+        }
+
+        /**
+         * @brief Returns a const reference to the internal data vector.
+         * 
+         * Useful for testing or building custom iterators.
+         * @return const Storage& Reference to the data vector.
+         */
+        const Storage& get_data() const {
+            return data;
+        }
+
+        /**
+         * @brief Hands the storage back out, leaving the container empty.
+         *
+         * The elements are moved, not copied. Iterators obtained earlier stay
+         * valid, since they hold their own orderings; spans from ordered_span()
+         * do not. A persistent container checkpoints its now empty contents.
+         * @return Storage The elements in insertion order.
+         */
+        Storage release() {
+            Storage released(data.get_allocator());
+            mutate([&] {
+                released = std::move(data);
+                data.clear();
+            });
+            checkpoint_if_persistent();
+            return released;
+        }
+
+        /**
+         * @brief Writes the container to a binary snapshot file.
+         * 
+         * The file holds a versioned header (type tag, element size, count,
+         * checksum) followed by the elements in insertion order. Trivially
+         * copyable elements are written with one write call per contiguous
+         * block of storage; strings are written length-prefixed.
+         * @param path File to create or overwrite.
+         * @param with_permutation If true, also stores the ascending permutation,
+         *        which lets MappedMyContainer traverse sorted orders without sorting.
+         * @throws std::runtime_error if the file cannot be written.
+         * @throws std::invalid_argument if a permutation is requested for elements without operator<.
+         */
+        void save(const std::string& path, bool with_permutation = false) const {
+            static_assert(snapshot::is_supported_v<T>, "Snapshots need trivially copyable elements or std::string");
+            std::vector<uint64_t> permutation;
+            if (with_permutation) {
+                permutation = ascending_permutation();
+            }
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                throw std::runtime_error("Cannot open snapshot: " + path);
+            }
+            snapshot::Header header = snapshot::make_header<T>(0, 0, 0);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            snapshot::Checksum checksum;
+            uint64_t payload = 0;
+            if constexpr (std::is_same_v<T, std::string>) {
+                for (size_t i = 0; i < data.size(); ++i) {
+                    uint64_t length = data[i].size();
+                    out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+                    out.write(data[i].data(), static_cast<std::streamsize>(length));
+                    checksum.update(&length, sizeof(length));
+                    checksum.update(data[i].data(), length);
+                    payload += sizeof(length) + length;
+                }
+            } else {
+                detail::for_each_segment(data, 0, data.size(), [&](const T* p, size_t n) {
+                    out.write(reinterpret_cast<const char*>(p), static_cast<std::streamsize>(n * sizeof(T)));
+                    checksum.update(p, n * sizeof(T));
+                });
+                payload = data.size() * sizeof(T);
+            }
+            uint32_t flags = 0;
+            if (with_permutation) {
+                snapshot::Checksum permutation_checksum;
+                permutation_checksum.update(permutation.data(), permutation.size() * sizeof(uint64_t));
+                uint64_t section_checksum = permutation_checksum.value();
+                static const char padding[8] = {};
+                out.write(padding, static_cast<std::streamsize>(snapshot::permutation_offset(payload) - sizeof(header) - payload));
+                out.write(reinterpret_cast<const char*>(&section_checksum), sizeof(section_checksum));
+                out.write(reinterpret_cast<const char*>(permutation.data()),
+                          static_cast<std::streamsize>(permutation.size() * sizeof(uint64_t)));
+                flags |= snapshot::ASCENDING_PERMUTATION;
+            }
+            header = snapshot::make_header<T>(data.size(), payload, checksum.value(), flags);
+            out.seekp(0);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            if (!out.flush()) {
+                throw std::runtime_error("Failed to write snapshot: " + path);
+            }
+        }
 
+        /**
+         * @brief Writes the elements in ascending order as a compressed snapshot.
+         * 
+         * Integral types only. The sorted elements are stored as delta-encoded
+         * varints, which typically shrinks snapshots several times; the
+         * insertion order is not preserved. Read it back with load() or stream
+         * it with CompressedSnapshot<T>.
+         * @param path File to create or overwrite.
+         * @throws std::runtime_error if the file cannot be written.
+         */
+        void save_compressed(const std::string& path) const {
+            static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "Compressed snapshots hold integral elements");
+            using U = std::make_unsigned_t<T>;
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                throw std::runtime_error("Cannot open snapshot: " + path);
+            }
+            snapshot::Header header = snapshot::make_header<T>(0, 0, 0);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            std::shared_ptr<const buffer_type> sorted = cached_ordering<Order::Ascending>();
+            snapshot::Checksum checksum;
+            uint64_t payload = 0;
+            std::string block;
+            auto flush = [&] {
+                out.write(block.data(), static_cast<std::streamsize>(block.size()));
+                checksum.update(block.data(), block.size());
+                payload += block.size();
+                block.clear();
+            };
+            for (size_t i = 0; i < sorted->size(); ++i) {
+                const T value = (*sorted)[i];
+                if (i == 0) {
+                    snapshot::append_varint(block, snapshot::zigzag(static_cast<int64_t>(value)));
+                } else {
+                    snapshot::append_varint(block, static_cast<U>(static_cast<U>(value) - static_cast<U>((*sorted)[i - 1])));
+                }
+                if (block.size() >= detail::OUTPUT_BUFFER) flush();
+            }
+            flush();
+            header = snapshot::make_header<T>(sorted->size(), payload, checksum.value(), snapshot::DELTA_VARINT);
+            out.seekp(0);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            if (!out.flush()) {
+                throw std::runtime_error("Failed to write snapshot: " + path);
+            }
+        }
 
         /**
-         * @brief Base class for all iterators in MyContainer.
+         * @brief Replaces the contents with the elements of a snapshot written by save().
          * 
-         * Manages a copy of the ordered data and traversal index.
-         * Provides common operator implementations for all derived iterators.
+         * Trivially copyable elements are read into pre-sized storage with one
+         * read call. A compressed snapshot is decoded and yields the elements
+         * in ascending order. The container is left unchanged if loading fails.
+         * @param path Snapshot file to read.
+         * @throws std::runtime_error if the file is missing, truncated, corrupt or holds another element type.
          */
-        template<typename IterType>
-        class BaseIterator {
-        protected:
-            std::vector<IterType> ordered_data;
-            size_t index = 0;
+        void load(const std::string& path) {
+            static_assert(snapshot::is_supported_v<T>, "Snapshots need trivially copyable elements or std::string");
+            std::ifstream in;
+            snapshot::Header header = snapshot::read_header<T>(in, path);
+            if (header.flags & snapshot::DELTA_VARINT) {
+                if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+                    CompressedSnapshot<T> compressed(path);
+                    compressed.verify();
+                    Storage decoded(data.get_allocator());
+                    decoded.reserve(compressed.size());
+                    for (auto it = compressed.begin_ascending_order(); it != compressed.end_ascending_order(); ++it) {
+                        decoded.push_back(*it);
+                    }
+                    mutate([&] { data = std::move(decoded); });
+                    checkpoint_if_persistent();
+                    return;
+                } else {
+                    throw std::runtime_error("Snapshot element type mismatch");
+                }
+            }
+            snapshot::Checksum checksum;
+            Storage loaded(data.get_allocator());
+            if constexpr (std::is_same_v<T, std::string>) {
+                loaded.reserve(header.count);
+                uint64_t remaining = header.payload_bytes;
+                for (uint64_t i = 0; i < header.count; ++i) {
+                    uint64_t length = 0;
+                    if (remaining < sizeof(length) || !in.read(reinterpret_cast<char*>(&length), sizeof(length)) ||
+                        length > remaining - sizeof(length)) {
+                        throw std::runtime_error("Snapshot is truncated");
+                    }
+                    std::string value(length, '\0');
+                    in.read(value.data(), static_cast<std::streamsize>(length));
+                    checksum.update(&length, sizeof(length));
+                    checksum.update(value.data(), length);
+                    remaining -= sizeof(length) + length;
+                    loaded.push_back(std::move(value));
+                }
+            } else if constexpr (detail::has_contiguous_data<Storage>::value) {
+                loaded.resize(header.count);
+                in.read(reinterpret_cast<char*>(loaded.data()), static_cast<std::streamsize>(header.payload_bytes));
+                checksum.update(loaded.data(), header.payload_bytes);
+            } else {
+                loaded.reserve(header.count);
+                std::vector<T> piece(detail::REDUCTION_BLOCK);
+                for (uint64_t done = 0; done < header.count && in;) {
+                    size_t n = static_cast<size_t>(std::min<uint64_t>(piece.size(), header.count - done));
+                    in.read(reinterpret_cast<char*>(piece.data()), static_cast<std::streamsize>(n * sizeof(T)));
+                    checksum.update(piece.data(), n * sizeof(T));
+                    for (size_t i = 0; i < n; ++i) loaded.push_back(piece[i]);
+                    done += n;
+                }
+            }
+            if (!in) {
+                throw std::runtime_error("Snapshot is truncated");
+            }
+            if (checksum.value() != header.checksum) {
+                throw std::runtime_error("Snapshot checksum mismatch");
+            }
+            mutate([&] { data = std::move(loaded); });
+            checkpoint_if_persistent();
+        }
 
-        public:
-            /**
-             * @brief Default constructor.
-             */
-            BaseIterator() = default;
+        /**
+         * @brief Makes the container durable in the given directory.
+         * 
+         * If the directory holds a previous state, the contents are replaced
+         * by it: the newest snapshot is loaded and the operation log written
+         * after it is replayed, dropping a record torn by a crash. Otherwise
+         * the current contents are checkpointed as the initial state. From
+         * then on every addElement and remove appends a record to the log, so
+         * restart time depends on the log tail rather than the whole history.
+         * @param directory Directory for snapshot and log files, created if missing.
+         * @param checkpoint_every Checkpoint in the background after this many logged mutations; 0 for manual checkpoints only.
+         *        The mutation that triggers it pays for an in-memory copy of the contents, not for the snapshot I/O.
+         * @throws std::runtime_error if the container is already persistent or the files cannot be read or written.
+         */
+        void open_persistent(const std::string& directory, size_t checkpoint_every = 0) {
+            static_assert(snapshot::is_supported_v<T>, "Persistence needs trivially copyable elements or std::string");
+            if (persistence) {
+                throw std::runtime_error("Container is already persistent");
+            }
+            std::filesystem::create_directories(directory);
+            uint64_t generation = 0;
+            bool has_snapshot = false;
+            for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+                uint64_t g;
+                if (parse_generation(entry.path().filename().string(), "snapshot.", g)) {
+                    if (!has_snapshot || g > generation) generation = g;
+                    has_snapshot = true;
+                }
+            }
+            const bool fresh = !has_snapshot && !std::filesystem::exists(log_path(directory, generation));
+            if (has_snapshot) {
+                load(snapshot_path(directory, generation));
+            } else if (!fresh) {
+                mutate([&] { data.clear(); });
+            }
+            uint64_t last = generation;
+            for (uint64_t g = generation; std::filesystem::exists(log_path(directory, g)); ++g) {
+                const std::string log_file = log_path(directory, g);
+                size_t intact = detail::OperationLog<T>::replay(log_file, [&](LogOp op, const T& value) {
+                    mutate([&] {
+                        if (op == LogOp::Add) {
+                            data.push_back(value);
+                        } else {
+                            data.erase(std::remove(data.begin(), data.end(), value), data.end());
+                        }
+                    });
+                });
+                std::filesystem::resize_file(log_file, intact);
+                last = g;
+            }
 
-             /**
-             * @brief Dereference operator.
-             * 
-             * @return const IterType& Reference to the current element.
-             * @throws std::out_of_range if attempting to dereference end().
-             */
-            const IterType& operator*() const {
-                if (index >= ordered_data.size()) {
-                    throw std::out_of_range("Dereferencing end() iterator");
+            auto attached = std::make_unique<Persistence>();
+            attached->directory = directory;
+            attached->generation = last;
+            attached->checkpoint_every = checkpoint_every;
+            attached->log = std::make_unique<detail::OperationLog<T>>(log_path(directory, last));
+            persistence = std::move(attached);
+            for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+                std::string name = entry.path().filename().string();
+                uint64_t g;
+                if ((parse_generation(name, "snapshot.", g) && g != generation) ||
+                    (parse_generation(name, "log.", g) && (g < generation || g > last)) ||
+                    (name.rfind("snapshot.", 0) == 0 && !parse_generation(name, "snapshot.", g))) {
+                    std::filesystem::remove(entry.path());
                 }
-                return ordered_data[index];
             }
-            /**
-             * @brief Prefix increment operator.
-             * 
-             * Advances the iterator to the next element.
-             * @return BaseIterator& Reference to the updated iterator.
-             */
-            BaseIterator& operator++() {
-                ++index;
-                return *this;
+            if (fresh || last != generation) {
+                checkpoint();
             }
+        }
 
-            /**
-             * @brief Inequality comparison operator.
-             * 
-             * @param other Another iterator to compare with.
-             * @return true if iterators point to different positions.
-             */
-            bool operator!=(const BaseIterator& other) const {
-                return index != other.index;
+        /**
+         * @brief Writes the contents as a new snapshot and starts an empty log.
+         * 
+         * Runs on the calling thread, after waiting for a pending background
+         * checkpoint. The snapshot is written to a temporary file, synced and
+         * renamed into place before the previous generations are deleted, so
+         * a crash at any point leaves a recoverable directory.
+         * @throws std::runtime_error if the container is not persistent or a file cannot be written.
+         */
+        void checkpoint() {
+            if (!persistence) {
+                throw std::runtime_error("Container is not persistent");
             }
+            join_checkpoint(*persistence);
+            const std::string& directory = persistence->directory;
+            const uint64_t next = persistence->generation + 1;
+            const std::string target = snapshot_path(directory, next);
+            save(target + ".tmp");
+            sync_path(target + ".tmp");
+            std::filesystem::rename(target + ".tmp", target);
+            std::filesystem::remove(log_path(directory, next));
+            persistence->log = std::make_unique<detail::OperationLog<T>>(log_path(directory, next));
+            sync_path(directory);
+            persistence->generation = next;
+            remove_generations_before(directory, next);
+        }
 
-             /**
-             * @brief Equality comparison operator.
-             * 
-             * @param other Another iterator to compare with.
-             * @return true if iterators point to the same position.
-             */
-            bool operator==(const BaseIterator& other) const {
-                return index == other.index;
+        /**
+         * @brief Waits until a periodic checkpoint running in the background is on disk.
+         * 
+         * @throws std::runtime_error if the container is not persistent, or the
+         *         error of a failed background checkpoint. The log still holds
+         *         every mutation after such a failure.
+         */
+        void wait_for_checkpoint() {
+            if (!persistence) {
+                throw std::runtime_error("Container is not persistent");
             }
+            join_checkpoint(*persistence);
+        }
 
-            /**
-             * @brief Assignment operator.
-             * 
-             * @param other Iterator to assign from.
-             * @return BaseIterator& Reference to this.
-             */
-            BaseIterator& operator=(const BaseIterator& other) {
-                if (this != &other) {
-                    this->ordered_data = other.ordered_data;
-                    this->index = other.index;
-                }
-                return *this;
+        /**
+         * @brief Forces the logged mutations to stable storage.
+         * 
+         * Records reach the operating system on every mutation and survive a
+         * process crash; sync() also makes them survive a power loss.
+         * @throws std::runtime_error if the container is not persistent.
+         */
+        void sync() const {
+            if (!persistence) {
+                throw std::runtime_error("Container is not persistent");
             }
+            persistence->log->sync();
+        }
 
-             /**
-             * @brief Returns the current position within the ordered data.
-             * 
-             * @return size_t Index of the iterator.
-             */
-            size_t position() const {
-                return index;
+        /**
+         * @brief Returns true if mutations are logged to disk.
+         */
+        bool is_persistent() const {
+            return persistence != nullptr;
+        }
+
+        /**
+         * @brief Stops logging. The files stay valid and can be reopened with open_persistent().
+         * 
+         * Waits for a pending background checkpoint.
+         * @throws the error of a failed background checkpoint; the container is closed anyway.
+         */
+        void close_persistent() {
+            std::unique_ptr<Persistence> closing = std::move(persistence);
+            if (closing) {
+                join_checkpoint(*closing);
             }
-        };
+        }
 
-    public:
         /**
-         * @brief Default constructor.
+         * @brief Returns the elements in the given traversal order as a contiguous span.
+         * 
+         * Zero-copy: the span points into the cached ordering (or, for
+         * insertion order over contiguous storage, into the storage itself),
+         * so it can be handed to numeric libraries or write() directly. It is
+         * valid until the next mutation of the container.
+         * @param order Traversal order to export.
+         * @return std::span<const T> Elements in traversal order.
          */
-        MyContainer() = default;
+        std::span<const T> ordered_span(Order order) const {
+            if constexpr (detail::has_contiguous_data<Storage>::value) {
+                if (order == Order::Insertion) {
+                    return std::span<const T>(data.data(), data.size());
+                }
+            }
+            std::shared_ptr<const buffer_type> ordered = cached_ordering(order);
+            return std::span<const T>(ordered->data(), ordered->size());
+        }
+
         /**
-         * @brief Adds a new element to the container.
+         * @brief Calls fn on every element in the given traversal order, in parallel.
          * 
-         * @param value The element to insert.
+         * The cached ordering is built at most once and split into chunks that are
+         * executed on the work-stealing pool. Calls on different elements may
+         * run concurrently and in any order.
+         * @param order Traversal order whose elements are visited.
+         * @param fn Callable taking const T&.
+         * @param grain Maximum number of elements per task.
+         * @param pool Pool executing the chunks.
          */
-        void addElement(const T& value) {
-            data.push_back(value);
+        template<typename Fn>
+        void parallel_for_each(Order order, Fn fn, size_t grain = 1024,
+                               WorkStealingPool& pool = WorkStealingPool::instance()) const {
+            std::shared_ptr<const buffer_type> shared = cached_ordering(order);
+            const buffer_type& ordered = *shared;
+            pool.parallel_for(0, ordered.size(), grain, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    fn(ordered[i]);
+                }
+            });
         }
 
         /**
-         * @brief Removes all occurrences of a given value from the container.
+         * @brief Transforms every element and reduces the results, in parallel.
          * 
-         * @param value The value to remove.
-         * @throws std::runtime_error if the value is not found.
+         * The ordering is cut into fixed chunks of grain elements; each chunk is
+         * reduced left to right and the chunk results are combined in traversal
+         * order. The result therefore does not depend on scheduling, which keeps
+         * floating-point reductions reproducible.
+         * @param order Traversal order to reduce.
+         * @param init Initial value, combined first.
+         * @param reduce Binary callable combining two R values.
+         * @param transform Callable mapping const T& to R.
+         * @param grain Number of elements per chunk.
+         * @param pool Pool executing the chunks.
+         * @return R The reduced value.
          */
-        void remove(const T& value) {
-            auto it = std::remove(data.begin(), data.end(), value);
-            if (it == data.end()) {
-                throw std::runtime_error("Item not found in container");
+        template<typename R, typename Reduce, typename Transform>
+        R parallel_transform_reduce(Order order, R init, Reduce reduce, Transform transform, size_t grain = 1024,
+                                    WorkStealingPool& pool = WorkStealingPool::instance()) const {
+            std::shared_ptr<const buffer_type> shared = cached_ordering(order);
+            const buffer_type& ordered = *shared;
+            if (grain == 0) grain = 1;
+            size_t chunks = (ordered.size() + grain - 1) / grain;
+            std::vector<R> partial(chunks);
+            pool.parallel_for(0, chunks, 1, [&](size_t lo, size_t hi) {
+                for (size_t c = lo; c < hi; ++c) {
+                    size_t first = c * grain;
+                    size_t last = std::min(first + grain, ordered.size());
+                    R acc = transform(ordered[first]);
+                    for (size_t i = first + 1; i < last; ++i) {
+                        acc = reduce(acc, transform(ordered[i]));
+                    }
+                    partial[c] = acc;
+                }
+            });
+            R result = init;
+            for (const R& value : partial) {
+                result = reduce(result, value);
             }
-            data.erase(it, data.end());
+            return result;
         }
 
+    private:
         /**
-         * @brief Returns the number of elements in the container.
+         * @brief Reduces the storage block by block and combines the block results in order.
+         *
+         * Blocks have a fixed size, so the combination order never depends on
+         * the execution mode or the number of threads.
+         */
+        template<typename R, typename BlockFn, typename Combine>
+        R reduce_blocks(Execution exec, R init, BlockFn block_fn, Combine combine) const {
+            const size_t block = detail::REDUCTION_BLOCK;
+            size_t blocks = (data.size() + block - 1) / block;
+            std::vector<R> partial(blocks);
+            auto run = [&](size_t lo, size_t hi) {
+                for (size_t b = lo; b < hi; ++b) {
+                    partial[b] = block_fn(b * block, std::min(data.size(), (b + 1) * block));
+                }
+            };
+            if (exec == Execution::Parallel) {
+                WorkStealingPool::instance().parallel_for(0, blocks, 4, run);
+            } else {
+                run(0, blocks);
+            }
+            R result = init;
+            for (const R& value : partial) {
+                result = combine(result, value);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Returns the smallest and largest element.
+         *
+         * @throws std::runtime_error if the container is empty.
+         */
+        std::pair<T, T> min_max(Execution exec) const {
+            if (data.size() == 0) {
+                throw std::runtime_error("Container is empty");
+            }
+            std::pair<T, T> first(data[0], data[0]);
+            return reduce_blocks(exec, first,
+                [this](size_t lo, size_t hi) {
+                    std::pair<T, T> acc(data[lo], data[lo]);
+                    detail::for_each_segment(data, lo, hi, [&acc](const T* p, size_t n) {
+                        std::pair<T, T> piece = detail::min_max_kernel(p, n);
+                        acc.first = detail::min_of(acc.first, piece.first);
+                        acc.second = detail::max_of(acc.second, piece.second);
+                    });
+                    return acc;
+                },
+                [](const std::pair<T, T>& a, const std::pair<T, T>& b) {
+                    return std::pair<T, T>(detail::min_of(a.first, b.first), detail::max_of(a.second, b.second));
+                });
+        }
+
+    public:
+        /**
+         * @brief Sums all elements directly over the storage.
          * 
-         * @return size_t Current size of the container.
+         * Uses AVX2 for float and double when available. Integers are summed
+         * in 64 bits. Blocks of a fixed size are summed independently and
+         * combined in insertion order, so the result is bit-for-bit the same
+         * in sequential and parallel mode. Summation::Deterministic also fixes
+         * the order inside a block, so the same storage sums to the same bits
+         * with or without AVX2.
+         * @param exec Sequential or parallel execution.
+         * @param summation Fast or deterministic floating-point summation.
+         * @return Sum of the elements, 0 for an empty container.
          */
-        size_t size() const {
-            return data.size();
+        detail::accumulator_t<T> sum(Execution exec = Execution::Sequential, Summation summation = Summation::Fast) const {
+            using Acc = detail::accumulator_t<T>;
+            const bool deterministic = summation == Summation::Deterministic;
+            return reduce_blocks(exec, Acc{},
+                [this, deterministic](size_t lo, size_t hi) {
+                    Acc acc{};
+                    detail::for_each_segment(data, lo, hi, [&acc, deterministic](const T* p, size_t n) {
+                        acc += detail::sum_kernel(p, n, deterministic);
+                    });
+                    return acc;
+                },
+                [](const Acc& a, const Acc& b) { return a + b; });
         }
 
         /**
-         * @brief Stream insertion operator.
+         * @brief Returns the smallest element.
          * 
-         * Outputs the contents of the container in standard format.
-         * @param os Output stream.
-         * @param container The container to print.
-         * @return std::ostream& The output stream.
+         * For floating-point elements a NaN anywhere yields NaN and -0 is
+         * smaller than +0, whichever kernel runs.
+         * @throws std::runtime_error if the container is empty.
+         */
+        T min(Execution exec = Execution::Sequential) const {
+            return min_max(exec).first;
+        }
+
+        /**
+         * @brief Returns the largest element.
+         * 
+         * For floating-point elements a NaN anywhere yields NaN and +0 is
+         * larger than -0, whichever kernel runs.
+         * @throws std::runtime_error if the container is empty.
+         */
+        T max(Execution exec = Execution::Sequential) const {
+            return min_max(exec).second;
+        }
+
+        /**
+         * @brief Returns the arithmetic mean of the elements.
+         * 
+         * @throws std::runtime_error if the container is empty.
          */
-        friend std::ostream& operator<<(std::ostream& os, const MyContainer<T>& container) {
-            os << "[";
-            for (size_t i = 0; i < container.data.size(); ++i) {
-                os << container.data[i];
-                if (i + 1 != container.data.size()) os << ", ";
+        double mean(Execution exec = Execution::Sequential, Summation summation = Summation::Fast) const {
+            if (data.size() == 0) {
+                throw std::runtime_error("Container is empty");
             }
-            os << "]";
-            return os;
+            return static_cast<double>(sum(exec, summation)) / static_cast<double>(data.size());
         }
 
         /**
-         * @brief Returns a const reference to the internal data vector.
+         * @brief Counts the elements satisfying pred.
          * 
-         * Useful for testing or building custom iterators.
-         * @return const std::vector<T>& Reference to the data vector.
+         * @param pred Callable taking const T& and returning bool.
+         * @param exec Sequential or parallel execution.
+         * @return size_t Number of matching elements.
          */
-        const std::vector<T>& get_data() const {
-            return data;
+        template<typename Pred>
+        size_t count_if(Pred pred, Execution exec = Execution::Sequential) const {
+            return reduce_blocks(exec, size_t(0),
+                [this, &pred](size_t lo, size_t hi) {
+                    size_t count = 0;
+                    detail::for_each_segment(data, lo, hi, [&](const T* p, size_t n) {
+                        for (size_t i = 0; i < n; ++i) {
+                            if (pred(p[i])) ++count;
+                        }
+                    });
+                    return count;
+                },
+                [](size_t a, size_t b) { return a + b; });
         }
 
         /**
@@ -174,7 +1831,7 @@ namespace containers {
          * Creates a sorted copy of the container's data in increasing order.
          * The `index` controls whether to start at the beginning or end.
          */
-        class AscendingOrderIterator : public BaseIterator<T> {
+        class AscendingOrderIterator : public BaseIterator<T, AscendingOrderIterator> {
         public:
             /**
              * @brief Constructs an AscendingOrderIterator.
@@ -182,11 +1839,49 @@ namespace containers {
              * @param original_data Original unordered container data.
              * @param begin If true, starts from index 0; otherwise from end.
              */
-            AscendingOrderIterator(const std::vector<T>& original_data, bool begin) {
-                this->ordered_data = original_data;
-                std::sort(this->ordered_data.begin(), this->ordered_data.end());
-                this->index = begin ? 0 : this->ordered_data.size();
+            AscendingOrderIterator(const Storage& original_data, bool begin)
+                : BaseIterator<T, AscendingOrderIterator>(build_ordering<Order::Ascending>(original_data), begin) {}
+
+            /**
+             * @brief Constructs a AscendingOrderIterator over a shared ordering.
+             * 
+             * @param ordering Elements in traversal order.
+             * @param begin If true, starts from index 0; otherwise from end.
+             */
+            AscendingOrderIterator(std::shared_ptr<const ordering_type> ordering, bool begin)
+                : BaseIterator<T, AscendingOrderIterator>(std::move(ordering), begin) {}
+
+            /**
+             * @brief Builds an AscendingOrderIterator over an ordering that is already sorted.
+             * 
+             * Lets producers that sort elsewhere (e.g. a parallel merge) hand over
+             * the result without a second sort.
+             * @param sorted Elements in ascending order.
+             * @param begin If true, starts from index 0; otherwise from end.
+             */
+            static AscendingOrderIterator from_sorted(ordering_type sorted, bool begin) {
+                return AscendingOrderIterator(std::move(sorted), begin);
+            }
+
+            /**
+             * @brief Builds a past-the-end sentinel for a traversal of count elements.
+             * 
+             * Holds no ordering and compares equal to any iterator that reached
+             * the end of its own ordering, so it also ends traversals whose
+             * length differs from count. position() returns count.
+             * @param count Number of elements of the traversal.
+             */
+            static AscendingOrderIterator end_of(size_t count) {
+                AscendingOrderIterator it;
+                it.index = count;
+                return it;
             }
+
+        private:
+            AscendingOrderIterator() = default;
+
+            AscendingOrderIterator(ordering_type&& sorted, bool begin)
+                : BaseIterator<T, AscendingOrderIterator>(std::move(sorted), begin) {}
         };
         /**
          * @brief Returns an iterator to the beginning of ascending order.
@@ -195,7 +1890,7 @@ namespace containers {
          */
         AscendingOrderIterator begin_ascending_order() const 
         { 
-            return AscendingOrderIterator(data, true);
+            return AscendingOrderIterator(cached_ordering<Order::Ascending>(), true);
         }
 
         /**
@@ -205,7 +1900,7 @@ namespace containers {
          */
         AscendingOrderIterator end_ascending_order() const 
         {
-            return AscendingOrderIterator(data, false); 
+            return AscendingOrderIterator(cached_ordering<Order::Ascending>(), false); 
         }
 
 
@@ -214,7 +1909,7 @@ namespace containers {
          * 
          * Creates a sorted copy of the container's data in decreasing order.
          */
-        class DescendingOrderIterator : public BaseIterator<T> {
+        class DescendingOrderIterator : public BaseIterator<T, DescendingOrderIterator> {
         public:
             /**
              * @brief Constructs a DescendingOrderIterator.
@@ -222,11 +1917,17 @@ namespace containers {
              * @param original_data Original unordered container data.
              * @param begin If true, starts from index 0; otherwise from end.
              */
-            DescendingOrderIterator(const std::vector<T>& original_data, bool begin) {
-                this->ordered_data = original_data;
-                std::sort(this->ordered_data.begin(), this->ordered_data.end(), std::greater<T>());
-                this->index = begin ? 0 : this->ordered_data.size();
-            }
+            DescendingOrderIterator(const Storage& original_data, bool begin)
+                : BaseIterator<T, DescendingOrderIterator>(build_ordering<Order::Descending>(original_data), begin) {}
+
+            /**
+             * @brief Constructs a DescendingOrderIterator over a shared ordering.
+             * 
+             * @param ordering Elements in traversal order.
+             * @param begin If true, starts from index 0; otherwise from end.
+             */
+            DescendingOrderIterator(std::shared_ptr<const ordering_type> ordering, bool begin)
+                : BaseIterator<T, DescendingOrderIterator>(std::move(ordering), begin) {}
         };
 
         /**
@@ -236,7 +1937,7 @@ namespace containers {
          */
         DescendingOrderIterator begin_descending_order() const 
         { 
-            return DescendingOrderIterator(data, true); 
+            return DescendingOrderIterator(cached_ordering<Order::Descending>(), true); 
         }
 
         /**
@@ -246,14 +1947,14 @@ namespace containers {
          */
         DescendingOrderIterator end_descending_order() const 
         { 
-            return DescendingOrderIterator(data, false); 
+            return DescendingOrderIterator(cached_ordering<Order::Descending>(), false); 
         }
 
         /**
          * @brief Iterator that traverses elements in a cross pattern:
          * smallest, largest, 2nd smallest, 2nd largest, etc.
          */
-        class SideCrossOrderIterator : public BaseIterator<T> {
+        class SideCrossOrderIterator : public BaseIterator<T, SideCrossOrderIterator> {
         public:
             /**
              * @brief Constructs a SideCrossOrderIterator.
@@ -263,41 +1964,37 @@ namespace containers {
              * @param original_data Original container elements.
              * @param begin Whether to initialize at the start (0) or at end().
              */
-            SideCrossOrderIterator(const std::vector<T>& original_data, bool begin) {
-                std::vector<T> sorted = original_data;
-                std::sort(sorted.begin(), sorted.end());
-                size_t left = 0, right = sorted.size() - 1;
-                while (left <= right) {
-                    if (left == right) this->ordered_data.push_back(sorted[left]);
-                    else {
-                        this->ordered_data.push_back(sorted[left]);
-                        this->ordered_data.push_back(sorted[right]);
-                    }
-                    ++left;
-                    if (right > 0) --right;
-                }
-                this->index = begin ? 0 : this->ordered_data.size();
-            }
+            SideCrossOrderIterator(const Storage& original_data, bool begin)
+                : BaseIterator<T, SideCrossOrderIterator>(build_ordering<Order::SideCross>(original_data), begin) {}
+
+            /**
+             * @brief Constructs a SideCrossOrderIterator over a shared ordering.
+             * 
+             * @param ordering Elements in traversal order.
+             * @param begin If true, starts from index 0; otherwise from end.
+             */
+            SideCrossOrderIterator(std::shared_ptr<const ordering_type> ordering, bool begin)
+                : BaseIterator<T, SideCrossOrderIterator>(std::move(ordering), begin) {}
         };
 
         /**
          * @brief Returns iterator to beginning of SideCrossOrder.
          */
         SideCrossOrderIterator begin_side_cross_order() const {
-            return SideCrossOrderIterator(data, true);
+            return SideCrossOrderIterator(cached_ordering<Order::SideCross>(), true);
         }
 
         /**
          * @brief Returns iterator to end of SideCrossOrder.
          */
         SideCrossOrderIterator end_side_cross_order() const {
-            return SideCrossOrderIterator(data, false);
+            return SideCrossOrderIterator(cached_ordering<Order::SideCross>(), false);
         }
 
         /**
          * @brief Iterator that traverses elements in reverse of insertion order.
          */
-        class ReverseOrderIterator : public BaseIterator<T> {
+        class ReverseOrderIterator : public BaseIterator<T, ReverseOrderIterator> {
         public:
             /**
              * @brief Constructs a ReverseOrderIterator.
@@ -307,31 +2004,37 @@ namespace containers {
              * @param original_data The elements in original insertion order.
              * @param begin Whether to initialize at start or end.
              */
-            ReverseOrderIterator(const std::vector<T>& original_data, bool begin) {
-                this->ordered_data = original_data;
-                std::reverse(this->ordered_data.begin(), this->ordered_data.end());
-                this->index = begin ? 0 : this->ordered_data.size();
-            }
+            ReverseOrderIterator(const Storage& original_data, bool begin)
+                : BaseIterator<T, ReverseOrderIterator>(build_ordering<Order::Reverse>(original_data), begin) {}
+
+            /**
+             * @brief Constructs a ReverseOrderIterator over a shared ordering.
+             * 
+             * @param ordering Elements in traversal order.
+             * @param begin If true, starts from index 0; otherwise from end.
+             */
+            ReverseOrderIterator(std::shared_ptr<const ordering_type> ordering, bool begin)
+                : BaseIterator<T, ReverseOrderIterator>(std::move(ordering), begin) {}
         };
 
         /**
          * @brief Returns iterator to beginning of reverse order.
          */
         ReverseOrderIterator begin_reverse_order() const {
-            return ReverseOrderIterator(data, true);
+            return ReverseOrderIterator(cached_ordering<Order::Reverse>(), true);
         }
 
         /**
          * @brief Returns iterator to end of reverse order.
          */
         ReverseOrderIterator end_reverse_order() const {
-            return ReverseOrderIterator(data, false);
+            return ReverseOrderIterator(cached_ordering<Order::Reverse>(), false);
         }
 
         /**
          * @brief Iterator that traverses elements in original insertion order.
          */
-        class OrderIterator : public BaseIterator<T> {
+        class OrderIterator : public BaseIterator<T, OrderIterator> {
         public:
             /**
              * @brief Constructs an OrderIterator.
@@ -341,23 +2044,30 @@ namespace containers {
              * @param original_data Raw container data.
              * @param begin Whether to begin at index 0 or end.
              */
-            OrderIterator(const std::vector<T>& original_data, bool begin) {
-                this->ordered_data = original_data;
-                this->index = begin ? 0 : this->ordered_data.size();
-            }
+            OrderIterator(const Storage& original_data, bool begin)
+                : BaseIterator<T, OrderIterator>(build_ordering<Order::Insertion>(original_data), begin) {}
+
+            /**
+             * @brief Constructs a OrderIterator over a shared ordering.
+             * 
+             * @param ordering Elements in traversal order.
+             * @param begin If true, starts from index 0; otherwise from end.
+             */
+            OrderIterator(std::shared_ptr<const ordering_type> ordering, bool begin)
+                : BaseIterator<T, OrderIterator>(std::move(ordering), begin) {}
         };
         /**
          * @brief Returns iterator to beginning of insertion order.
          */
         OrderIterator begin_order() const {
-            return OrderIterator(data, true);
+            return OrderIterator(cached_ordering<Order::Insertion>(), true);
         }
 
         /**
          * @brief Returns iterator to end of insertion order.
          */
         OrderIterator end_order() const {
-            return OrderIterator(data, false);
+            return OrderIterator(cached_ordering<Order::Insertion>(), false);
         }
 
         /**
@@ -365,7 +2075,7 @@ namespace containers {
          * 
          * Starts from the middle, then alternates left/right.
          */
-        class MiddleOutOrderIterator : public BaseIterator<T> {
+        class MiddleOutOrderIterator : public BaseIterator<T, MiddleOutOrderIterator> {
         public:
             /**
              * @brief Constructs a MiddleOutOrderIterator.
@@ -375,38 +2085,112 @@ namespace containers {
              * @param original_data The container's current elements.
              * @param begin Whether to start at index 0 or end.
              */
-            MiddleOutOrderIterator(const std::vector<T>& original_data, bool begin) {
-                size_t n = original_data.size();
-                size_t mid = n / 2;
-                if (n == 0) {
-                    this->index = 0;
-                    return;
-                }
-                this->ordered_data.push_back(original_data[mid]);
-                int left = static_cast<int>(mid) - 1;
-                size_t right = mid + 1;
-                bool takeLeft = false;
-                while (left >= 0 || right < n) {
-                    if (takeLeft && left >= 0) this->ordered_data.push_back(original_data[left--]);
-                    else if (!takeLeft && right < n) this->ordered_data.push_back(original_data[right++]);
-                    takeLeft = !takeLeft;
-                }
-                this->index = begin ? 0 : this->ordered_data.size();
-            }
+            MiddleOutOrderIterator(const Storage& original_data, bool begin)
+                : BaseIterator<T, MiddleOutOrderIterator>(build_ordering<Order::MiddleOut>(original_data), begin) {}
+
+            /**
+             * @brief Constructs a MiddleOutOrderIterator over a shared ordering.
+             * 
+             * @param ordering Elements in traversal order.
+             * @param begin If true, starts from index 0; otherwise from end.
+             */
+            MiddleOutOrderIterator(std::shared_ptr<const ordering_type> ordering, bool begin)
+                : BaseIterator<T, MiddleOutOrderIterator>(std::move(ordering), begin) {}
         };
         /**
          * @brief Returns iterator to beginning of middle-out traversal.
          */
         MiddleOutOrderIterator begin_middle_out_order() const {
-            return MiddleOutOrderIterator(data, true);
+            return MiddleOutOrderIterator(cached_ordering<Order::MiddleOut>(), true);
         }
 
         /**
          * @brief Returns iterator to end of middle-out traversal.
          */
         MiddleOutOrderIterator end_middle_out_order() const {
-            return MiddleOutOrderIterator(data, false);
+            return MiddleOutOrderIterator(cached_ordering<Order::MiddleOut>(), false);
+        }
+
+        /**
+         * @brief Streams the elements in insertion order without any buffer.
+         * 
+         * The container must outlive the generator and must not be modified while streaming.
+         * @return Generator<T> Lazy sequence of the elements.
+         */
+        Generator<T> stream_order() const {
+            for (size_t i = 0; i < data.size(); ++i) {
+                co_yield data[i];
+            }
+        }
+
+        /**
+         * @brief Streams the elements in reverse insertion order without any buffer.
+         */
+        Generator<T> stream_reverse() const {
+            for (size_t i = data.size(); i > 0; --i) {
+                co_yield data[i - 1];
+            }
+        }
+
+        /**
+         * @brief Streams the elements from the middle outward without any buffer.
+         */
+        Generator<T> stream_middle_out() const {
+            const size_t n = data.size();
+            for (size_t k = 0; k < n; ++k) {
+                co_yield data[detail::middle_out_index(n, k)];
+            }
+        }
+
+        /**
+         * @brief Streams the elements in ascending order.
+         * 
+         * Heapifies a copy in O(n) and pops one element per step, so the first
+         * element is available without sorting everything.
+         */
+        Generator<T> stream_ascending() const {
+            buffer_type heap(data.begin(), data.end(), data.get_allocator());
+            std::make_heap(heap.begin(), heap.end(), std::greater<T>());
+            while (!heap.empty()) {
+                std::pop_heap(heap.begin(), heap.end(), std::greater<T>());
+                co_yield heap.back();
+                heap.pop_back();
+            }
+        }
+
+        /**
+         * @brief Streams the elements in descending order, popping a max-heap lazily.
+         */
+        Generator<T> stream_descending() const {
+            buffer_type heap(data.begin(), data.end(), data.get_allocator());
+            std::make_heap(heap.begin(), heap.end());
+            while (!heap.empty()) {
+                std::pop_heap(heap.begin(), heap.end());
+                co_yield heap.back();
+                heap.pop_back();
+            }
+        }
+
+        /**
+         * @brief Streams the elements in side-cross order.
+         * 
+         * Side-cross needs both ends of the sorted sequence, so this stream sorts a copy first.
+         */
+        Generator<T> stream_side_cross() const {
+            buffer_type sorted(data.begin(), data.end(), data.get_allocator());
+            std::sort(sorted.begin(), sorted.end());
+            for (size_t k = 0; k < sorted.size(); ++k) {
+                co_yield sorted[detail::side_cross_index(sorted.size(), k)];
+            }
         }
     };
 
+    namespace pmr {
+        /**
+         * @brief MyContainer whose storage and iterator buffers use a std::pmr::memory_resource.
+         */
+        template<typename T = int>
+        using MyContainer = containers::MyContainer<T, std::pmr::vector<T>>;
+    }
+
 }
\ No newline at end of file
@@ -0,0 +1,233 @@
+//fadinujedat062@gmail.com
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "MyContainer.hpp"
+#include "ExternalSort.hpp"
+
+namespace containers {
+    /**
+     * @brief Non-owning, read-only container over elements that live elsewhere.
+     *
+     * Wraps a std::span<const T> and offers the six traversal orders without
+     * copying the elements. Sorted orders go through an ascending index
+     * permutation, either supplied by the caller or built once, on first use.
+     * The viewed elements must outlive the view and its iterators and must
+     * not change while they are in use.
+     */
+    template<typename T = int>
+    class MyContainerView {
+    public:
+        using value_type = T;
+
+    private:
+        enum class Mapping { Forward, Backward, SideCross, MiddleOut };
+
+        std::span<const T> elements;
+        std::span<const uint64_t> stored_permutation;///< Caller-supplied permutation, possibly empty
+
+        mutable std::once_flag permutation_once;
+        mutable std::vector<uint64_t> built_permutation;
+
+        /**
+         * @brief Returns the ascending permutation, building it on first use.
+         */
+        const uint64_t* permutation() const {
+            if (!stored_permutation.empty() || elements.empty()) {
+                return stored_permutation.data();
+            }
+            std::call_once(permutation_once, [this] {
+                built_permutation.resize(elements.size());
+                for (size_t i = 0; i < built_permutation.size(); ++i) built_permutation[i] = i;
+                std::stable_sort(built_permutation.begin(), built_permutation.end(),
+                                 [this](uint64_t a, uint64_t b) { return elements[a] < elements[b]; });
+            });
+            return built_permutation.data();
+        }
+
+    public:
+        /**
+         * @brief Iterator computing the element position from its traversal index.
+         *
+         * Sorted orders go through the permutation; the others map the index
+         * directly onto the viewed elements.
+         */
+        class ViewIterator {
+            const T* elements = nullptr;
+            const uint64_t* order = nullptr;///< Ascending permutation, or null for unsorted orders
+            Mapping mapping = Mapping::Forward;
+            size_t count = 0;
+            size_t index = 0;
+
+            friend class MyContainerView;
+
+            ViewIterator(const T* elements, const uint64_t* order, Mapping mapping, size_t count, bool begin)
+                : elements(elements), order(order), mapping(mapping), count(count), index(begin ? 0 : count) {}
+
+        public:
+            ViewIterator() = default;
+
+            /**
+             * @brief Dereference operator.
+             *
+             * @return const T& Reference to the viewed element.
+             * @throws std::out_of_range if attempting to dereference end() or
+             *         if a permutation index is out of range.
+             */
+            const T& operator*() const {
+                if (!elements || index >= count) {
+                    throw std::out_of_range("Dereferencing end() iterator");
+                }
+                size_t k = index;
+                switch (mapping) {
+                    case Mapping::Backward: k = count - 1 - index; break;
+                    case Mapping::SideCross: k = detail::side_cross_index(count, index); break;
+                    case Mapping::MiddleOut: k = detail::middle_out_index(count, index); break;
+                    default: break;
+                }
+                if (order) {
+                    k = static_cast<size_t>(order[k]);
+                    if (k >= count) {
+                        throw std::out_of_range("Permutation index out of range");
+                    }
+                }
+                return elements[k];
+            }
+
+            ViewIterator& operator++() {
+                ++index;
+                return *this;
+            }
+
+            bool operator!=(const ViewIterator& other) const {
+                return index != other.index;
+            }
+
+            bool operator==(const ViewIterator& other) const {
+                return index == other.index;
+            }
+
+            size_t position() const {
+                return index;
+            }
+        };
+
+        using AscendingOrderIterator = ViewIterator;
+        using DescendingOrderIterator = ViewIterator;
+        using SideCrossOrderIterator = ViewIterator;
+        using ReverseOrderIterator = ViewIterator;
+        using OrderIterator = ViewIterator;
+        using MiddleOutOrderIterator = ViewIterator;
+
+        /**
+         * @brief Views elements in insertion order.
+         *
+         * @param elements The viewed elements.
+         * @param ascending_permutation Optional indices into elements in ascending
+         *        order of the elements; built lazily when empty.
+         * @throws std::invalid_argument if a non-empty permutation has the wrong length.
+         */
+        explicit MyContainerView(std::span<const T> elements, std::span<const uint64_t> ascending_permutation = {})
+            : elements(elements), stored_permutation(ascending_permutation) {
+            if (!stored_permutation.empty() && stored_permutation.size() != elements.size()) {
+                throw std::invalid_argument("Permutation length does not match the elements");
+            }
+        }
+
+        /**
+         * @brief Copy constructor. Shares the viewed elements; a built permutation is rebuilt on demand.
+         */
+        MyContainerView(const MyContainerView& other)
+            : elements(other.elements), stored_permutation(other.stored_permutation) {}
+
+        MyContainerView& operator=(const MyContainerView&) = delete;
+
+        /**
+         * @brief Returns the number of viewed elements.
+         */
+        size_t size() const {
+            return elements.size();
+        }
+
+        /**
+         * @brief Returns the viewed elements in insertion order.
+         */
+        std::span<const T> get_data() const {
+            return elements;
+        }
+
+        /**
+         * @brief Returns true if sorted orders use a caller-supplied permutation.
+         */
+        bool has_stored_permutation() const {
+            return !stored_permutation.empty();
+        }
+
+        /**
+         * @brief Sorts the viewed elements out of core, under a memory budget.
+         *
+         * Needs no permutation in memory, so it suits views of data larger than RAM.
+         * @param memory_budget Bytes of elements held in memory at a time.
+         * @param directory Directory for the temporary run files.
+         */
+        ExternalSort<T> external_sort(size_t memory_budget,
+                                      const std::string& directory = std::filesystem::temp_directory_path().string()) const {
+            return ExternalSort<T>(elements.begin(), elements.end(), memory_budget, directory);
+        }
+
+        AscendingOrderIterator begin_ascending_order() const {
+            return AscendingOrderIterator(elements.data(), permutation(), Mapping::Forward, size(), true);
+        }
+
+        AscendingOrderIterator end_ascending_order() const {
+            return AscendingOrderIterator(elements.data(), nullptr, Mapping::Forward, size(), false);
+        }
+
+        DescendingOrderIterator begin_descending_order() const {
+            return DescendingOrderIterator(elements.data(), permutation(), Mapping::Backward, size(), true);
+        }
+
+        DescendingOrderIterator end_descending_order() const {
+            return DescendingOrderIterator(elements.data(), nullptr, Mapping::Backward, size(), false);
+        }
+
+        SideCrossOrderIterator begin_side_cross_order() const {
+            return SideCrossOrderIterator(elements.data(), permutation(), Mapping::SideCross, size(), true);
+        }
+
+        SideCrossOrderIterator end_side_cross_order() const {
+            return SideCrossOrderIterator(elements.data(), nullptr, Mapping::SideCross, size(), false);
+        }
+
+        ReverseOrderIterator begin_reverse_order() const {
+            return ReverseOrderIterator(elements.data(), nullptr, Mapping::Backward, size(), true);
+        }
+
+        ReverseOrderIterator end_reverse_order() const {
+            return ReverseOrderIterator(elements.data(), nullptr, Mapping::Backward, size(), false);
+        }
+
+        OrderIterator begin_order() const {
+            return OrderIterator(elements.data(), nullptr, Mapping::Forward, size(), true);
+        }
+
+        OrderIterator end_order() const {
+            return OrderIterator(elements.data(), nullptr, Mapping::Forward, size(), false);
+        }
+
+        MiddleOutOrderIterator begin_middle_out_order() const {
+            return MiddleOutOrderIterator(elements.data(), nullptr, Mapping::MiddleOut, size(), true);
+        }
+
+        MiddleOutOrderIterator end_middle_out_order() const {
+            return MiddleOutOrderIterator(elements.data(), nullptr, Mapping::MiddleOut, size(), false);
+        }
+    };
+
+}
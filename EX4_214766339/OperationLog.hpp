@@ -0,0 +1,197 @@
+//fadinujedat062@gmail.com
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <fcntl.h>
+#include <unistd.h>
+#include "MappedFile.hpp"
+#include "Snapshot.hpp"
+#include "TextFormat.hpp"
+
+namespace containers {
+    namespace detail {
+        /**
+         * @brief Append-only log of container mutations.
+         *
+         * Every record is written with a single write call as
+         * [op: 1 byte][length: 4 bytes][element: length bytes][check: 4 bytes],
+         * where the check is the low half of the snapshot checksum of the
+         * preceding bytes. Trivially copyable elements are stored as their raw
+         * bytes, strings as their characters. A record torn by a crash fails
+         * its check and ends the replay; a write that fails while the process
+         * runs is cut off again, so later records stay reachable.
+         */
+        template<typename T>
+        class OperationLog {
+        public:
+            enum class Op : uint8_t { Add = 1, Remove = 2 };
+
+        private:
+            int fd = -1;
+            size_t appended = 0;
+            off_t intact = 0;///< Bytes of intact records in the file
+            off_t last = 0;///< Offset of the last appended record
+            bool failed = false;///< A torn record could not be cut off
+            std::string record;
+
+            /**
+             * @brief Cuts the file back to offset, marking the log failed if that is impossible.
+             */
+            void truncate_to(off_t offset) {
+                if (::ftruncate(fd, offset) != 0) {
+                    failed = true;
+                    throw std::runtime_error("Failed to truncate operation log");
+                }
+                intact = offset;
+            }
+
+            static const char* bytes_of(const T& value) {
+                if constexpr (std::is_same_v<T, std::string>) {
+                    return value.data();
+                } else {
+                    return reinterpret_cast<const char*>(&value);
+                }
+            }
+
+            static uint32_t size_of(const T& value) {
+                if constexpr (std::is_same_v<T, std::string>) {
+                    return static_cast<uint32_t>(value.size());
+                } else {
+                    return static_cast<uint32_t>(sizeof(T));
+                }
+            }
+
+            static uint32_t check(const char* p, size_t n) {
+                snapshot::Checksum checksum;
+                checksum.update(p, n);
+                return static_cast<uint32_t>(checksum.value());
+            }
+
+        public:
+            /**
+             * @brief Opens path for appending, creating it if needed.
+             *
+             * @throws std::runtime_error if the file cannot be opened.
+             */
+            explicit OperationLog(const std::string& path) {
+                static_assert(snapshot::is_supported_v<T>, "Logged containers need trivially copyable elements or std::string");
+                fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+                if (fd < 0) {
+                    throw std::runtime_error("Cannot open operation log: " + path);
+                }
+                intact = last = ::lseek(fd, 0, SEEK_END);
+                if (intact < 0) {
+                    ::close(fd);
+                    throw std::runtime_error("Cannot open operation log: " + path);
+                }
+            }
+
+            OperationLog(const OperationLog&) = delete;
+            OperationLog& operator=(const OperationLog&) = delete;
+
+            ~OperationLog() {
+                ::close(fd);
+            }
+
+            /**
+             * @brief Appends one record.
+             *
+             * A partially written record is truncated away before the error
+             * propagates, leaving the log as it was.
+             * @throws std::runtime_error if the write fails or an earlier torn
+             *         record could not be removed.
+             */
+            void append(Op op, const T& value) {
+                if (failed) {
+                    throw std::runtime_error("Operation log holds a torn record");
+                }
+                uint32_t length = size_of(value);
+                record.clear();
+                record.push_back(static_cast<char>(op));
+                record.append(reinterpret_cast<const char*>(&length), sizeof(length));
+                record.append(bytes_of(value), length);
+                uint32_t sum = check(record.data(), record.size());
+                record.append(reinterpret_cast<const char*>(&sum), sizeof(sum));
+                try {
+                    FdSink{fd}(record.data(), record.size());
+                } catch (...) {
+                    truncate_to(intact);
+                    throw;
+                }
+                last = intact;
+                intact += static_cast<off_t>(record.size());
+                ++appended;
+            }
+
+            /**
+             * @brief Removes the record written by the last append().
+             *
+             * Used when the mutation it describes fails. Only one record can be undone.
+             * @throws std::runtime_error if the file cannot be truncated.
+             */
+            void undo_last() {
+                if (intact == last) return;
+                truncate_to(last);
+                --appended;
+            }
+
+            /**
+             * @brief Returns the number of records appended through this object.
+             */
+            size_t size() const {
+                return appended;
+            }
+
+            /**
+             * @brief Forces the appended records to stable storage.
+             */
+            void sync() const {
+                if (::fdatasync(fd) != 0) {
+                    throw std::runtime_error("Failed to sync operation log");
+                }
+            }
+
+            /**
+             * @brief Calls fn(op, value) for every intact record of the log at path.
+             *
+             * Stops at the first truncated or corrupt record.
+             * @return size_t Length in bytes of the intact prefix; 0 if the file does not exist.
+             */
+            template<typename Fn>
+            static size_t replay(const std::string& path, Fn&& fn) {
+                if (!std::filesystem::exists(path)) {
+                    return 0;
+                }
+                MappedFile file(path, true);
+                const char* p = file.data();
+                size_t offset = 0;
+                const size_t frame = 1 + sizeof(uint32_t) + sizeof(uint32_t);
+                while (file.size() - offset >= frame) {
+                    uint32_t length;
+                    std::memcpy(&length, p + offset + 1, sizeof(length));
+                    if (length > file.size() - offset - frame) break;
+                    const size_t body = 1 + sizeof(uint32_t) + length;
+                    uint32_t sum;
+                    std::memcpy(&sum, p + offset + body, sizeof(sum));
+                    Op op = static_cast<Op>(p[offset]);
+                    if (sum != check(p + offset, body) || (op != Op::Add && op != Op::Remove)) break;
+                    const char* element = p + offset + 1 + sizeof(uint32_t);
+                    if constexpr (std::is_same_v<T, std::string>) {
+                        fn(op, std::string(element, length));
+                    } else {
+                        if (length != sizeof(T)) break;
+                        T value;
+                        std::memcpy(&value, element, sizeof(T));
+                        fn(op, value);
+                    }
+                    offset += body + sizeof(sum);
+                }
+                return offset;
+            }
+        };
+    }
+}
@@ -0,0 +1,296 @@
+//fadinujedat062@gmail.com
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MYCONTAINER_AVX2_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+namespace containers {
+    namespace detail {
+        /**
+         * @brief Accumulator type of sum(): 64-bit for integers, T itself otherwise.
+         */
+        template<typename T>
+        using accumulator_t = std::conditional_t<std::is_integral_v<T>,
+                                                 std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>,
+                                                 T>;
+
+        /**
+         * @brief Number of elements reduced as one unit. Partial results of
+         * blocks are always combined in block order, independent of threading.
+         */
+        constexpr size_t REDUCTION_BLOCK = 4096;
+
+        /**
+         * @brief Lanes of the deterministic summation order.
+         *
+         * Lane k accumulates elements 16i + k; lanes k and k + 8 are added,
+         * the eight results are combined as a balanced tree, and the tail past
+         * the last full group of 16 is added left to right.
+         */
+        constexpr size_t SUM_LANES = 16;
+
+        /**
+         * @brief Smaller of a and b: NaN wins, -0 is below +0, ties keep a.
+         */
+        template<typename T>
+        T min_of(const T& a, const T& b) {
+            if constexpr (std::is_floating_point_v<T>) {
+                if (std::isnan(a) || std::isnan(b)) return std::numeric_limits<T>::quiet_NaN();
+                if (a == b) return std::signbit(b) ? b : a;
+            }
+            return b < a ? b : a;
+        }
+
+        /**
+         * @brief Larger of a and b: NaN wins, +0 is above -0, ties keep a.
+         */
+        template<typename T>
+        T max_of(const T& a, const T& b) {
+            if constexpr (std::is_floating_point_v<T>) {
+                if (std::isnan(a) || std::isnan(b)) return std::numeric_limits<T>::quiet_NaN();
+                if (a == b) return std::signbit(a) ? b : a;
+            }
+            return a < b ? b : a;
+        }
+
+        template<typename S, typename = void>
+        struct has_contiguous_data : std::false_type {};
+
+        template<typename S>
+        struct has_contiguous_data<S, std::void_t<decltype(std::declval<const S&>().data())>> : std::true_type {};
+
+        template<typename S, typename = void>
+        struct has_chunks : std::false_type {};
+
+        template<typename S>
+        struct has_chunks<S, std::void_t<decltype(S::chunk_size())>> : std::true_type {};
+
+        /**
+         * @brief Calls fn(const T* first, size_t count) on contiguous pieces covering [lo, hi) of storage.
+         *
+         * Vector-like storage yields one piece, chunked storage one piece per
+         * chunk, and any other storage small copied pieces.
+         */
+        template<typename Storage, typename Fn>
+        void for_each_segment(const Storage& storage, size_t lo, size_t hi, Fn&& fn) {
+            using T = typename Storage::value_type;
+            if (lo >= hi) return;
+            if constexpr (has_contiguous_data<Storage>::value) {
+                fn(storage.data() + lo, hi - lo);
+            } else if constexpr (has_chunks<Storage>::value) {
+                constexpr size_t chunk = Storage::chunk_size();
+                while (lo < hi) {
+                    size_t n = std::min(hi, (lo / chunk + 1) * chunk) - lo;
+                    fn(&storage[lo], n);
+                    lo += n;
+                }
+            } else {
+                T piece[256];
+                while (lo < hi) {
+                    size_t n = std::min<size_t>(hi - lo, 256);
+                    std::copy(storage.begin() + lo, storage.begin() + lo + n, piece);
+                    fn(static_cast<const T*>(piece), n);
+                    lo += n;
+                }
+            }
+        }
+
+#ifdef MYCONTAINER_AVX2_DISPATCH
+        inline bool cpu_has_avx2() {
+            static const bool supported = __builtin_cpu_supports("avx2");
+            return supported;
+        }
+
+        /**
+         * @brief Sums in the SUM_LANES order, bit for bit like sum_lanes().
+         */
+        __attribute__((target("avx2"))) inline double sum_avx2(const double* p, size_t n) {
+            __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+            __m256d a2 = _mm256_setzero_pd(), a3 = _mm256_setzero_pd();
+            size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                a0 = _mm256_add_pd(a0, _mm256_loadu_pd(p + i));
+                a1 = _mm256_add_pd(a1, _mm256_loadu_pd(p + i + 4));
+                a2 = _mm256_add_pd(a2, _mm256_loadu_pd(p + i + 8));
+                a3 = _mm256_add_pd(a3, _mm256_loadu_pd(p + i + 12));
+            }
+            alignas(32) double t[8];
+            _mm256_store_pd(t, _mm256_add_pd(a0, a2));
+            _mm256_store_pd(t + 4, _mm256_add_pd(a1, a3));
+            double total = ((t[0] + t[1]) + (t[2] + t[3])) + ((t[4] + t[5]) + (t[6] + t[7]));
+            for (; i < n; ++i) total += p[i];
+            return total;
+        }
+
+        /**
+         * @brief Sums in the SUM_LANES order, bit for bit like sum_lanes().
+         */
+        __attribute__((target("avx2"))) inline float sum_avx2(const float* p, size_t n) {
+            __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps();
+            size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                a0 = _mm256_add_ps(a0, _mm256_loadu_ps(p + i));
+                a1 = _mm256_add_ps(a1, _mm256_loadu_ps(p + i + 8));
+            }
+            alignas(32) float lanes[8];
+            _mm256_store_ps(lanes, _mm256_add_ps(a0, a1));
+            float total = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+            for (; i < n; ++i) total += p[i];
+            return total;
+        }
+
+        /**
+         * @brief Smallest and largest of n > 0 elements with the min_of/max_of semantics.
+         *
+         * NaNs are collected in a mask; equal lanes merge sign bits so that
+         * -0 wins the minimum and +0 the maximum.
+         */
+        __attribute__((target("avx2"))) inline std::pair<double, double> min_max_avx2(const double* p, size_t n) {
+            const __m256d ones = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+            __m256d lo = _mm256_set1_pd(p[0]), hi = lo, nan = _mm256_setzero_pd();
+            size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m256d v = _mm256_loadu_pd(p + i);
+                __m256d eq = _mm256_cmp_pd(v, lo, _CMP_EQ_OQ);
+                lo = _mm256_or_pd(_mm256_min_pd(v, lo), _mm256_and_pd(eq, v));
+                eq = _mm256_cmp_pd(v, hi, _CMP_EQ_OQ);
+                hi = _mm256_and_pd(_mm256_max_pd(v, hi), _mm256_or_pd(_mm256_and_pd(eq, v), _mm256_andnot_pd(eq, ones)));
+                nan = _mm256_or_pd(nan, _mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+            }
+            if (_mm256_movemask_pd(nan) != 0) {
+                return {std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN()};
+            }
+            alignas(32) double l[4], h[4];
+            _mm256_store_pd(l, lo);
+            _mm256_store_pd(h, hi);
+            double mn = l[0], mx = h[0];
+            for (size_t k = 1; k < 4; ++k) {
+                mn = min_of(mn, l[k]);
+                mx = max_of(mx, h[k]);
+            }
+            for (; i < n; ++i) {
+                mn = min_of(mn, p[i]);
+                mx = max_of(mx, p[i]);
+            }
+            return {mn, mx};
+        }
+
+        /**
+         * @brief Smallest and largest of n > 0 elements with the min_of/max_of semantics.
+         */
+        __attribute__((target("avx2"))) inline std::pair<float, float> min_max_avx2(const float* p, size_t n) {
+            const __m256 ones = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            __m256 lo = _mm256_set1_ps(p[0]), hi = lo, nan = _mm256_setzero_ps();
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m256 v = _mm256_loadu_ps(p + i);
+                __m256 eq = _mm256_cmp_ps(v, lo, _CMP_EQ_OQ);
+                lo = _mm256_or_ps(_mm256_min_ps(v, lo), _mm256_and_ps(eq, v));
+                eq = _mm256_cmp_ps(v, hi, _CMP_EQ_OQ);
+                hi = _mm256_and_ps(_mm256_max_ps(v, hi), _mm256_or_ps(_mm256_and_ps(eq, v), _mm256_andnot_ps(eq, ones)));
+                nan = _mm256_or_ps(nan, _mm256_cmp_ps(v, v, _CMP_UNORD_Q));
+            }
+            if (_mm256_movemask_ps(nan) != 0) {
+                return {std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::quiet_NaN()};
+            }
+            alignas(32) float l[8], h[8];
+            _mm256_store_ps(l, lo);
+            _mm256_store_ps(h, hi);
+            float mn = l[0], mx = h[0];
+            for (size_t k = 1; k < 8; ++k) {
+                mn = min_of(mn, l[k]);
+                mx = max_of(mx, h[k]);
+            }
+            for (; i < n; ++i) {
+                mn = min_of(mn, p[i]);
+                mx = max_of(mx, p[i]);
+            }
+            return {mn, mx};
+        }
+#endif
+
+        /**
+         * @brief Sums n elements in the SUM_LANES order, on any target.
+         */
+        template<typename T>
+        accumulator_t<T> sum_lanes(const T* p, size_t n) {
+            accumulator_t<T> lanes[SUM_LANES] = {};
+            size_t i = 0;
+            for (; i + SUM_LANES <= n; i += SUM_LANES) {
+                for (size_t k = 0; k < SUM_LANES; ++k) lanes[k] += p[i + k];
+            }
+            accumulator_t<T> t[8];
+            for (size_t k = 0; k < 8; ++k) t[k] = lanes[k] + lanes[k + 8];
+            accumulator_t<T> total = ((t[0] + t[1]) + (t[2] + t[3])) + ((t[4] + t[5]) + (t[6] + t[7]));
+            for (; i < n; ++i) total += p[i];
+            return total;
+        }
+
+        /**
+         * @brief Sums n elements.
+         *
+         * Dispatches to AVX2 for float and double when the CPU supports it.
+         * Otherwise the fast mode uses four independent accumulators and the
+         * deterministic mode sum_lanes(), whose order the AVX2 kernels share,
+         * so deterministic sums are identical on every target.
+         */
+        template<typename T>
+        accumulator_t<T> sum_kernel(const T* p, size_t n, bool deterministic = false) {
+#ifdef MYCONTAINER_AVX2_DISPATCH
+            if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
+                if (cpu_has_avx2()) return sum_avx2(p, n);
+            }
+#endif
+            if constexpr (std::is_floating_point_v<T>) {
+                if (deterministic) return sum_lanes(p, n);
+            }
+            accumulator_t<T> a0{}, a1{}, a2{}, a3{};
+            size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                a0 += p[i];
+                a1 += p[i + 1];
+                a2 += p[i + 2];
+                a3 += p[i + 3];
+            }
+            for (; i < n; ++i) a0 += p[i];
+            return (a0 + a1) + (a2 + a3);
+        }
+
+        /**
+         * @brief Returns the smallest and largest of n > 0 elements without SIMD.
+         */
+        template<typename T>
+        std::pair<T, T> min_max_scalar(const T* p, size_t n) {
+            T mn = p[0], mx = p[0];
+            for (size_t i = 1; i < n; ++i) {
+                mn = min_of(mn, p[i]);
+                mx = max_of(mx, p[i]);
+            }
+            return {mn, mx};
+        }
+
+        /**
+         * @brief Returns the smallest and largest of n > 0 elements.
+         *
+         * A NaN makes both results NaN, and -0 orders below +0, on the AVX2
+         * and the scalar path alike.
+         */
+        template<typename T>
+        std::pair<T, T> min_max_kernel(const T* p, size_t n) {
+#ifdef MYCONTAINER_AVX2_DISPATCH
+            if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
+                if (cpu_has_avx2()) return min_max_avx2(p, n);
+            }
+#endif
+            return min_max_scalar(p, n);
+        }
+    }
+}
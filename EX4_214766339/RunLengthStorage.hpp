@@ -0,0 +1,536 @@
+//fadinujedat062@gmail.com
+#pragma once
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <unordered_map>
+#include "MyContainer.hpp"
+
+namespace containers {
+    /**
+     * @brief Run-length storage: one multiplicity per distinct value plus a compact insertion log.
+     *
+     * A hash index maps every distinct value to a slot holding the value and
+     * its multiplicity; this is the primary storage, so count(), size() and
+     * the sorted orders only ever touch distinct values. Insertion order is
+     * kept separately as a log of (slot, length) runs, needed only by the
+     * insertion, reverse and middle-out orders. remove() retires the value's
+     * slot in O(1) on average and leaves its runs in the log as tombstones;
+     * the log is compacted once tombstones make up half of it, so removal
+     * stays amortized O(1) per distinct value.
+     */
+    template<typename T, typename Hash = std::hash<T>>
+    class RunLengthStorage {
+    public:
+        using value_type = T;
+        using allocator_type = std::allocator<T>;
+        using run_type = std::pair<T, size_t>;
+
+    private:
+        /**
+         * @brief A distinct value and its multiplicity.
+         */
+        struct Slot {
+            T value;
+            size_t count = 0;
+            size_t runs = 0;///< Number of log runs referring to this slot
+            bool live = true;
+        };
+
+        /**
+         * @brief length consecutive insertions of the value held by slot.
+         */
+        struct LogRun {
+            size_t slot;
+            size_t length;
+        };
+
+        std::unordered_map<T, size_t, Hash> index;///< Value -> slot of a live value
+        std::vector<Slot> slots;
+        std::vector<LogRun> log;///< Insertion order, possibly with runs of retired slots
+        size_t dead_runs = 0;
+        size_t total = 0;
+
+        /**
+         * @brief Drops the runs and slots of removed values and merges runs left adjacent.
+         */
+        void compact() {
+            std::vector<size_t> remap(slots.size(), 0);
+            std::vector<Slot> kept;
+            for (size_t s = 0; s < slots.size(); ++s) {
+                if (!slots[s].live) continue;
+                remap[s] = kept.size();
+                kept.push_back(std::move(slots[s]));
+                kept.back().runs = 0;
+            }
+            size_t out = 0;
+            for (size_t i = 0; i < log.size(); ++i) {
+                if (!slots[log[i].slot].live) continue;
+                size_t slot = remap[log[i].slot];
+                if (out != 0 && log[out - 1].slot == slot) {
+                    log[out - 1].length += log[i].length;
+                } else {
+                    log[out++] = LogRun{slot, log[i].length};
+                    ++kept[slot].runs;
+                }
+            }
+            log.resize(out);
+            for (auto& entry : index) {
+                entry.second = remap[entry.second];
+            }
+            slots = std::move(kept);
+            dead_runs = 0;
+        }
+
+    public:
+        RunLengthStorage() = default;
+
+        /**
+         * @brief Adds one occurrence of value, extending the last run if it holds the same value.
+         *
+         * @param value The element to insert.
+         */
+        void push_back(const T& value) {
+            auto [found, inserted] = index.try_emplace(value, slots.size());
+            if (inserted) {
+                slots.push_back(Slot{value});
+            }
+            size_t slot = found->second;
+            if (!log.empty() && log.back().slot == slot) {
+                ++log.back().length;
+            } else {
+                log.push_back(LogRun{slot, 1});
+                ++slots[slot].runs;
+            }
+            ++slots[slot].count;
+            ++total;
+        }
+
+        /**
+         * @brief Removes every occurrence of value.
+         *
+         * O(1) on average: the value's slot is retired and its runs become
+         * tombstones that traversals skip; the log is compacted when
+         * tombstones reach half of it.
+         * @return size_t Number of removed occurrences.
+         */
+        size_t remove(const T& value) {
+            auto found = index.find(value);
+            if (found == index.end()) {
+                return 0;
+            }
+            Slot& slot = slots[found->second];
+            index.erase(found);
+            slot.live = false;
+            dead_runs += slot.runs;
+            total -= slot.count;
+            size_t removed = slot.count;
+            if (2 * dead_runs > log.size()) {
+                compact();
+            }
+            return removed;
+        }
+
+        /**
+         * @brief Returns the multiplicity of value.
+         */
+        size_t count(const T& value) const {
+            auto found = index.find(value);
+            return found == index.end() ? 0 : slots[found->second].count;
+        }
+
+        /**
+         * @brief Builds the runs of the stored values in insertion order.
+         *
+         * Skips tombstones and merges runs they separated; O(log size).
+         */
+        std::vector<run_type> runs() const {
+            std::vector<run_type> out;
+            for (const LogRun& run : log) {
+                const Slot& slot = slots[run.slot];
+                if (!slot.live) continue;
+                if (!out.empty() && out.back().first == slot.value) {
+                    out.back().second += run.length;
+                } else {
+                    out.emplace_back(slot.value, run.length);
+                }
+            }
+            return out;
+        }
+
+        /**
+         * @brief Returns one (value, multiplicity) pair per distinct value, in no particular order.
+         */
+        std::vector<run_type> multiplicities() const {
+            std::vector<run_type> out;
+            out.reserve(index.size());
+            for (const auto& entry : index) {
+                out.emplace_back(entry.first, slots[entry.second].count);
+            }
+            return out;
+        }
+
+        /**
+         * @brief Number of runs in the insertion log, tombstones included.
+         */
+        size_t log_size() const { return log.size(); }
+
+        /**
+         * @brief Returns false if log run i belongs to a removed value.
+         */
+        bool run_live(size_t i) const { return slots[log[i].slot].live; }
+
+        /**
+         * @brief Value of log run i.
+         */
+        const T& run_value(size_t i) const { return slots[log[i].slot].value; }
+
+        /**
+         * @brief Length of log run i.
+         */
+        size_t run_length(size_t i) const { return log[i].length; }
+
+        size_t size() const { return total; }
+        size_t distinct() const { return index.size(); }
+        bool empty() const { return total == 0; }
+        allocator_type get_allocator() const { return allocator_type(); }
+    };
+
+    /**
+     * @brief MyContainer in run-length multiplicity mode.
+     *
+     * Sorted orders sort the distinct values only; insertion, reverse and
+     * middle-out orders walk the insertion log. Iterators expand the counts
+     * on the fly with run cursors instead of materializing every element.
+     * The storage is held through a shared_ptr: iterators over the log share
+     * the storage they were created from, and the first mutation while one
+     * is alive copies the storage instead of changing it under it.
+     */
+    template<typename T, typename Hash>
+    class MyContainer<T, RunLengthStorage<T, Hash>> {
+    public:
+        using value_type = T;
+        using storage_type = RunLengthStorage<T, Hash>;
+        using allocator_type = typename storage_type::allocator_type;
+
+    private:
+        using run_type = typename storage_type::run_type;
+
+        std::shared_ptr<storage_type> data = std::make_shared<storage_type>();///< Run storage for container elements
+
+        /**
+         * @brief How a traversal step maps onto an expanded position.
+         */
+        enum class Mapping { Forward, Backward, SideCross, MiddleOut };
+
+        /**
+         * @brief Distinct values with their multiplicities, sorted ascending.
+         */
+        std::shared_ptr<const std::vector<run_type>> sorted_runs() const {
+            std::vector<run_type> sorted = data->multiplicities();
+            std::sort(sorted.begin(), sorted.end(),
+                      [](const run_type& a, const run_type& b) { return a.first < b.first; });
+            return std::make_shared<const std::vector<run_type>>(std::move(sorted));
+        }
+
+        /**
+         * @brief Returns the storage for mutation, copying it first if an iterator still shares it.
+         */
+        storage_type& writable() {
+            if (data.use_count() > 1) {
+                data = std::make_shared<storage_type>(*data);
+            }
+            return *data;
+        }
+
+    public:
+        /**
+         * @brief Iterator expanding runs on the fly.
+         *
+         * Walks either the sorted distinct values or the insertion log with
+         * two (run, offset) cursors: every traversal order visits each next
+         * position one step after the front cursor or one step before the
+         * back cursor, so advancing is amortized O(1) and dereferencing is
+         * O(1). position() counts expanded elements, so iterators behave
+         * exactly as if every occurrence were stored individually.
+         */
+        class ExpandingIterator {
+            /**
+             * @brief Expanded position pos lies at offset within run.
+             */
+            struct Cursor {
+                size_t run = 0;
+                size_t offset = 0;
+                size_t pos = 0;
+            };
+
+            std::shared_ptr<const std::vector<run_type>> sorted;///< Sorted distinct values, for sorted orders
+            std::shared_ptr<const storage_type> source;///< Storage snapshot, for insertion-based orders
+            Mapping mapping = Mapping::Forward;
+            size_t count = 0;
+            size_t index = 0;
+            Cursor front;
+            Cursor back;
+
+            friend class MyContainer;
+
+            ExpandingIterator(std::shared_ptr<const std::vector<run_type>> sorted,
+                              std::shared_ptr<const storage_type> source, Mapping mapping, size_t count)
+                : sorted(std::move(sorted)), source(std::move(source)), mapping(mapping), count(count) {
+                if (count == 0) return;
+                front = seek(target(0));
+                back = (mapping == Mapping::SideCross) ? seek(count - 1) : front;
+            }
+
+            /**
+             * @brief Builds a past-the-end sentinel.
+             *
+             * Holds no runs and compares equal to any iterator that reached
+             * the end of its own traversal. position() returns count.
+             */
+            static ExpandingIterator end_of(size_t count) {
+                ExpandingIterator it;
+                it.count = count;
+                it.index = count;
+                return it;
+            }
+
+            size_t runs() const { return sorted ? sorted->size() : source->log_size(); }
+            bool live(size_t run) const { return sorted || source->run_live(run); }
+            size_t length(size_t run) const { return sorted ? (*sorted)[run].second : source->run_length(run); }
+            const T& value(size_t run) const { return sorted ? (*sorted)[run].first : source->run_value(run); }
+
+            size_t target(size_t k) const {
+                switch (mapping) {
+                    case Mapping::Backward: return count - 1 - k;
+                    case Mapping::SideCross: return detail::side_cross_index(count, k);
+                    case Mapping::MiddleOut: return detail::middle_out_index(count, k);
+                    default: return k;
+                }
+            }
+
+            /**
+             * @brief Locates an expanded position, scanning from the nearer end.
+             */
+            Cursor seek(size_t pos) const {
+                if (pos < count / 2) {
+                    size_t skip = pos;
+                    for (size_t run = 0;; ++run) {
+                        if (!live(run)) continue;
+                        if (skip < length(run)) return Cursor{run, skip, pos};
+                        skip -= length(run);
+                    }
+                }
+                size_t skip = count - 1 - pos;
+                for (size_t run = runs(); run-- > 0;) {
+                    if (!live(run)) continue;
+                    if (skip < length(run)) return Cursor{run, length(run) - 1 - skip, pos};
+                    skip -= length(run);
+                }
+                return Cursor{};
+            }
+
+            void advance(Cursor& cursor) const {
+                ++cursor.pos;
+                if (++cursor.offset < length(cursor.run)) return;
+                cursor.offset = 0;
+                do {
+                    ++cursor.run;
+                } while (!live(cursor.run));
+            }
+
+            void retreat(Cursor& cursor) const {
+                --cursor.pos;
+                if (cursor.offset > 0) {
+                    --cursor.offset;
+                    return;
+                }
+                do {
+                    --cursor.run;
+                } while (!live(cursor.run));
+                cursor.offset = length(cursor.run) - 1;
+            }
+
+        public:
+            ExpandingIterator() = default;
+
+            /**
+             * @brief Dereference operator.
+             *
+             * @return const T& Reference to the value of the current run.
+             * @throws std::out_of_range if attempting to dereference end().
+             */
+            const T& operator*() const {
+                if ((!sorted && !source) || index >= count) {
+                    throw std::out_of_range("Dereferencing end() iterator");
+                }
+                return value(target(index) == front.pos ? front.run : back.run);
+            }
+
+            ExpandingIterator& operator++() {
+                if (++index >= count) return *this;
+                size_t pos = target(index);
+                if (pos == front.pos || pos == back.pos) return *this;
+                if (pos == front.pos + 1) {
+                    advance(front);
+                } else {
+                    retreat(back);
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Equality comparison operator.
+             *
+             * The end sentinel equals any iterator at or past the end of its own traversal.
+             */
+            bool operator==(const ExpandingIterator& other) const {
+                bool ends = !sorted && !source;
+                bool other_ends = !other.sorted && !other.source;
+                if (!ends && other_ends) return index >= count;
+                if (ends && !other_ends) return other.index >= other.count;
+                return index == other.index;
+            }
+
+            bool operator!=(const ExpandingIterator& other) const {
+                return !(*this == other);
+            }
+
+            size_t position() const {
+                return index;
+            }
+        };
+
+        using AscendingOrderIterator = ExpandingIterator;
+        using DescendingOrderIterator = ExpandingIterator;
+        using SideCrossOrderIterator = ExpandingIterator;
+        using ReverseOrderIterator = ExpandingIterator;
+        using OrderIterator = ExpandingIterator;
+        using MiddleOutOrderIterator = ExpandingIterator;
+
+        /**
+         * @brief Default constructor.
+         */
+        MyContainer() = default;
+
+        /**
+         * @brief Copy constructor. Copies the storage; iterators of other keep theirs.
+         */
+        MyContainer(const MyContainer& other) : data(std::make_shared<storage_type>(*other.data)) {}
+
+        /**
+         * @brief Copy assignment.
+         */
+        MyContainer& operator=(const MyContainer& other) {
+            if (this != &other) {
+                data = std::make_shared<storage_type>(*other.data);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Adds one occurrence of value.
+         *
+         * @param value The element to insert.
+         */
+        void addElement(const T& value) {
+            writable().push_back(value);
+        }
+
+        /**
+         * @brief Removes all occurrences of a given value in amortized O(1).
+         *
+         * @param value The value to remove.
+         * @throws std::runtime_error if the value is not found.
+         */
+        void remove(const T& value) {
+            if (data->count(value) == 0 || writable().remove(value) == 0) {
+                throw std::runtime_error("Item not found in container");
+            }
+        }
+
+        /**
+         * @brief Returns the number of stored elements, counting duplicates.
+         */
+        size_t size() const {
+            return data->size();
+        }
+
+        /**
+         * @brief Returns the run storage.
+         */
+        const storage_type& get_data() const {
+            return *data;
+        }
+
+        allocator_type get_allocator() const {
+            return data->get_allocator();
+        }
+
+        /**
+         * @brief Stream insertion operator. Prints every occurrence in insertion order.
+         */
+        friend std::ostream& operator<<(std::ostream& os, const MyContainer& container) {
+            os << "[";
+            for (auto it = container.begin_order(); it != container.end_order(); ++it) {
+                if (it.position() != 0) os << ", ";
+                os << *it;
+            }
+            os << "]";
+            return os;
+        }
+
+        AscendingOrderIterator begin_ascending_order() const {
+            return AscendingOrderIterator(sorted_runs(), nullptr, Mapping::Forward, size());
+        }
+
+        AscendingOrderIterator end_ascending_order() const {
+            return AscendingOrderIterator::end_of(size());
+        }
+
+        DescendingOrderIterator begin_descending_order() const {
+            return DescendingOrderIterator(sorted_runs(), nullptr, Mapping::Backward, size());
+        }
+
+        DescendingOrderIterator end_descending_order() const {
+            return DescendingOrderIterator::end_of(size());
+        }
+
+        SideCrossOrderIterator begin_side_cross_order() const {
+            return SideCrossOrderIterator(sorted_runs(), nullptr, Mapping::SideCross, size());
+        }
+
+        SideCrossOrderIterator end_side_cross_order() const {
+            return SideCrossOrderIterator::end_of(size());
+        }
+
+        ReverseOrderIterator begin_reverse_order() const {
+            return ReverseOrderIterator(nullptr, data, Mapping::Backward, size());
+        }
+
+        ReverseOrderIterator end_reverse_order() const {
+            return ReverseOrderIterator::end_of(size());
+        }
+
+        OrderIterator begin_order() const {
+            return OrderIterator(nullptr, data, Mapping::Forward, size());
+        }
+
+        OrderIterator end_order() const {
+            return OrderIterator::end_of(size());
+        }
+
+        MiddleOutOrderIterator begin_middle_out_order() const {
+            return MiddleOutOrderIterator(nullptr, data, Mapping::MiddleOut, size());
+        }
+
+        MiddleOutOrderIterator end_middle_out_order() const {
+            return MiddleOutOrderIterator::end_of(size());
+        }
+    };
+
+}
@@ -0,0 +1,311 @@
+//fadinujedat062@gmail.com
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace containers {
+    namespace snapshot {
+        /**
+         * @brief Fixed 48-byte header at the start of every binary snapshot.
+         *
+         * Fields are stored in native byte order; a file written with the
+         * other byte order fails the version check. The payload starts right
+         * after the header, so it is 16-byte aligned within the file.
+         */
+        struct Header {
+            char magic[8];///< "MYCSNAP" followed by a zero byte
+            uint32_t version;///< Format version, FORMAT_VERSION
+            uint32_t type_tag;///< type_tag<T>() of the element type
+            uint32_t element_size;///< sizeof(T), or 0 for length-prefixed strings
+            uint32_t flags;///< Optional sections following the payload
+            uint64_t count;///< Number of elements
+            uint64_t payload_bytes;///< Size of the element payload in bytes
+            uint64_t checksum;///< Checksum of the payload bytes
+        };
+
+        static_assert(sizeof(Header) == 48, "Snapshot header must stay 48 bytes");
+
+        constexpr char MAGIC[8] = {'M', 'Y', 'C', 'S', 'N', 'A', 'P', '\0'};
+        constexpr uint32_t FORMAT_VERSION = 2;
+
+        /**
+         * @brief Header flag: an ascending permutation section follows the payload.
+         *
+         * The section starts at permutation_offset() and holds a uint64_t
+         * checksum of the indices followed by count uint64_t indices into the
+         * payload, in stable ascending order of the elements.
+         */
+        constexpr uint32_t ASCENDING_PERMUTATION = 1;
+
+        /**
+         * @brief Header flag: the payload holds the elements in ascending order as delta varints.
+         *
+         * Integral types only. The first element is stored zigzag-encoded,
+         * every following one as its non-negative difference to the previous
+         * element, each as a little-endian base-128 varint. payload_bytes is
+         * the compressed size; insertion order is not preserved.
+         */
+        constexpr uint32_t DELTA_VARINT = 2;
+
+        /**
+         * @brief Appends value as a base-128 varint, 7 bits per byte, low bits first.
+         */
+        inline void append_varint(std::string& out, uint64_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<char>(value));
+        }
+
+        /**
+         * @brief Decodes one varint at p and advances p past it.
+         *
+         * @throws std::runtime_error if the varint runs past end or exceeds 64 bits.
+         */
+        inline uint64_t read_varint(const char*& p, const char* end) {
+            uint64_t value = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7) {
+                if (p == end) {
+                    throw std::runtime_error("Snapshot is truncated");
+                }
+                uint8_t byte = static_cast<uint8_t>(*p++);
+                value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                if ((byte & 0x80) == 0) {
+                    return value;
+                }
+            }
+            throw std::runtime_error("Corrupt snapshot varint");
+        }
+
+        inline uint64_t zigzag(int64_t value) {
+            return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+        }
+
+        inline int64_t unzigzag(uint64_t value) {
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+
+        /**
+         * @brief File offset of the permutation section: the end of the payload rounded up to 8 bytes.
+         */
+        constexpr uint64_t permutation_offset(uint64_t payload_bytes) {
+            return (sizeof(Header) + payload_bytes + 7) / 8 * 8;
+        }
+
+        /**
+         * @brief True for element types a snapshot can hold: trivially copyable types and std::string.
+         */
+        template<typename T>
+        constexpr bool is_supported_v = std::is_trivially_copyable_v<T> || std::is_same_v<T, std::string>;
+
+        /**
+         * @brief Identifies the element type stored in a snapshot.
+         *
+         * Encodes the kind (signed, unsigned, floating point, string, other
+         * trivially copyable) in the high byte and sizeof(T) in the low bits.
+         */
+        template<typename T>
+        constexpr uint32_t type_tag() {
+            if constexpr (std::is_same_v<T, std::string>) {
+                return 0x400;
+            } else if constexpr (std::is_floating_point_v<T>) {
+                return 0x300 | static_cast<uint32_t>(sizeof(T));
+            } else if constexpr (std::is_integral_v<T>) {
+                return (std::is_signed_v<T> ? 0x100u : 0x200u) | static_cast<uint32_t>(sizeof(T));
+            } else {
+                return 0x500 | static_cast<uint32_t>(sizeof(T));
+            }
+        }
+
+        /**
+         * @brief Incremental XXH64 checksum (seed 0).
+         *
+         * Four independent lanes consume 32-byte stripes with a multiply and
+         * rotate per 64-bit word, and the result goes through a final
+         * avalanche, so every input bit affects every output bit and
+         * multi-bit corruptions do not cancel out. Bytes fed in pieces hash
+         * the same as in one call.
+         */
+        class Checksum {
+        private:
+            static constexpr uint64_t P1 = 0x9E3779B185EBCA87ull;
+            static constexpr uint64_t P2 = 0xC2B2AE3D27D4EB4Full;
+            static constexpr uint64_t P3 = 0x165667B19E3779F9ull;
+            static constexpr uint64_t P4 = 0x85EBCA77C2B2AE63ull;
+            static constexpr uint64_t P5 = 0x27D4EB2F165667C5ull;
+
+            uint64_t lanes[4] = {P1 + P2, P2, 0, 0 - P1};
+            unsigned char pending[32] = {};
+            size_t pending_size = 0;
+            uint64_t total = 0;
+
+            static uint64_t rotl(uint64_t x, int r) {
+                return (x << r) | (x >> (64 - r));
+            }
+
+            static uint64_t round(uint64_t acc, uint64_t input) {
+                return rotl(acc + input * P2, 31) * P1;
+            }
+
+            static uint64_t merge(uint64_t acc, uint64_t lane) {
+                return (acc ^ round(0, lane)) * P1 + P4;
+            }
+
+            static uint64_t read64(const unsigned char* p) {
+                uint64_t word;
+                std::memcpy(&word, p, sizeof(word));
+                return word;
+            }
+
+            void stripe(const unsigned char* p) {
+                for (int i = 0; i < 4; ++i) {
+                    lanes[i] = round(lanes[i], read64(p + 8 * i));
+                }
+            }
+
+        public:
+            void update(const void* bytes, size_t size) {
+                const unsigned char* p = static_cast<const unsigned char*>(bytes);
+                total += size;
+                if (pending_size != 0) {
+                    size_t take = std::min(size, sizeof(pending) - pending_size);
+                    std::memcpy(pending + pending_size, p, take);
+                    pending_size += take;
+                    p += take;
+                    size -= take;
+                    if (pending_size < sizeof(pending)) return;
+                    stripe(pending);
+                    pending_size = 0;
+                }
+                for (; size >= sizeof(pending); p += sizeof(pending), size -= sizeof(pending)) {
+                    stripe(p);
+                }
+                std::memcpy(pending, p, size);
+                pending_size = size;
+            }
+
+            uint64_t value() const {
+                uint64_t h;
+                if (total >= sizeof(pending)) {
+                    h = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+                    for (uint64_t lane : lanes) h = merge(h, lane);
+                } else {
+                    h = P5;
+                }
+                h += total;
+                const unsigned char* p = pending;
+                size_t left = pending_size;
+                for (; left >= 8; p += 8, left -= 8) {
+                    h = rotl(h ^ round(0, read64(p)), 27) * P1 + P4;
+                }
+                if (left >= 4) {
+                    uint32_t half;
+                    std::memcpy(&half, p, sizeof(half));
+                    h = rotl(h ^ (static_cast<uint64_t>(half) * P1), 23) * P2 + P3;
+                    p += 4;
+                    left -= 4;
+                }
+                for (; left > 0; ++p, --left) {
+                    h = rotl(h ^ (*p * P5), 11) * P1;
+                }
+                h ^= h >> 33;
+                h *= P2;
+                h ^= h >> 29;
+                h *= P3;
+                h ^= h >> 32;
+                return h;
+            }
+        };
+
+        /**
+         * @brief Builds the header for count elements of T.
+         */
+        template<typename T>
+        Header make_header(uint64_t count, uint64_t payload_bytes, uint64_t checksum, uint32_t flags = 0) {
+            Header header{};
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = FORMAT_VERSION;
+            header.type_tag = type_tag<T>();
+            header.element_size = std::is_same_v<T, std::string> ? 0 : static_cast<uint32_t>(sizeof(T));
+            header.flags = flags;
+            header.count = count;
+            header.payload_bytes = payload_bytes;
+            header.checksum = checksum;
+            return header;
+        }
+
+        /**
+         * @brief Checks that a header describes a snapshot of T.
+         *
+         * @param header Header read from a file.
+         * @param file_size Total size of the file in bytes.
+         * @throws std::runtime_error describing the first mismatch, including
+         *         a count or payload that does not fit the file.
+         */
+        template<typename T>
+        void validate(const Header& header, uint64_t file_size) {
+            if (file_size < sizeof(Header)) {
+                throw std::runtime_error("Snapshot is truncated");
+            }
+            if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+                throw std::runtime_error("Not a container snapshot");
+            }
+            if (header.version != FORMAT_VERSION) {
+                throw std::runtime_error("Unsupported snapshot version");
+            }
+            if (header.type_tag != type_tag<T>()) {
+                throw std::runtime_error("Snapshot element type mismatch");
+            }
+            if (header.payload_bytes > file_size - sizeof(Header)) {
+                throw std::runtime_error("Snapshot is truncated");
+            }
+            // Every element takes at least one payload byte (a varint, a
+            // string length prefix or the element itself), so count is
+            // bounded by the payload, which is bounded by the file size.
+            // Divisions instead of multiplications keep the checks free of overflow.
+            if constexpr (std::is_same_v<T, std::string>) {
+                if (header.count > header.payload_bytes / sizeof(uint64_t)) {
+                    throw std::runtime_error("Snapshot element count mismatch");
+                }
+            } else {
+                if (header.element_size != sizeof(T)) {
+                    throw std::runtime_error("Snapshot element size mismatch");
+                }
+                if (header.flags & DELTA_VARINT) {
+                    if (header.count > header.payload_bytes) {
+                        throw std::runtime_error("Snapshot element count mismatch");
+                    }
+                } else if (header.payload_bytes % sizeof(T) != 0 || header.count != header.payload_bytes / sizeof(T)) {
+                    throw std::runtime_error("Snapshot element size mismatch");
+                }
+            }
+        }
+
+        /**
+         * @brief Opens path and reads and validates its header.
+         *
+         * @throws std::runtime_error if the file cannot be read or is not a snapshot of T.
+         */
+        template<typename T>
+        Header read_header(std::ifstream& in, const std::string& path) {
+            in.open(path, std::ios::binary | std::ios::ate);
+            if (!in) {
+                throw std::runtime_error("Cannot open snapshot: " + path);
+            }
+            uint64_t file_size = static_cast<uint64_t>(in.tellg());
+            in.seekg(0);
+            Header header;
+            if (file_size < sizeof(Header) || !in.read(reinterpret_cast<char*>(&header), sizeof(Header))) {
+                throw std::runtime_error("Snapshot is truncated");
+            }
+            validate<T>(header, file_size);
+            return header;
+        }
+    }
+}
@@ -0,0 +1,459 @@
+//fadinujedat062@gmail.com
+#pragma once
+#include <iostream>
+#include <vector>
+#include <tuple>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include "MyContainer.hpp"
+
+namespace containers {
+    /**
+     * @brief Field declaration for structure-of-arrays storage.
+     *
+     * Specialize for an aggregate type to list its fields as member pointers.
+     * The first field is the ordering key:
+     *
+     *     template<> struct soa_traits<Trade> {
+     *         static constexpr auto fields = std::make_tuple(&Trade::price, &Trade::qty, &Trade::id);
+     *     };
+     */
+    template<typename T>
+    struct soa_traits;
+
+    namespace detail {
+        template<typename M>
+        struct member_type;
+
+        template<typename C, typename F>
+        struct member_type<F C::*> {
+            using type = F;
+        };
+
+        template<typename Tuple>
+        struct soa_columns;
+
+        template<typename... Members>
+        struct soa_columns<std::tuple<Members...>> {
+            using type = std::tuple<std::vector<typename member_type<Members>::type>...>;
+        };
+    }
+
+    /**
+     * @brief Structure-of-arrays storage: one contiguous column per declared field.
+     *
+     * Records are split into their fields on insertion and reassembled on access,
+     * so operations that only look at the key touch a single dense column.
+     */
+    template<typename T>
+    class SoAStorage {
+        using fields_type = std::remove_const_t<decltype(soa_traits<T>::fields)>;
+        static constexpr size_t field_count = std::tuple_size_v<fields_type>;
+        static_assert(field_count > 0, "soa_traits must declare at least one field");
+
+    public:
+        using value_type = T;
+        using allocator_type = std::allocator<T>;
+        using key_type = typename detail::member_type<std::tuple_element_t<0, fields_type>>::type;
+
+    private:
+        typename detail::soa_columns<fields_type>::type columns;
+
+        template<size_t... I>
+        void push_fields(const T& value, std::index_sequence<I...>) {
+            (std::get<I>(columns).push_back(value.*std::get<I>(soa_traits<T>::fields)), ...);
+        }
+
+        template<size_t... I>
+        T gather(size_t i, std::index_sequence<I...>) const {
+            T value{};
+            ((value.*std::get<I>(soa_traits<T>::fields) = std::get<I>(columns)[i]), ...);
+            return value;
+        }
+
+        template<size_t... I>
+        void compact(const std::vector<bool>& keep, std::index_sequence<I...>) {
+            (compact_column(std::get<I>(columns), keep), ...);
+        }
+
+        template<typename Column>
+        static void compact_column(Column& column, const std::vector<bool>& keep) {
+            size_t out = 0;
+            for (size_t i = 0; i < column.size(); ++i) {
+                if (!keep[i]) continue;
+                if (out != i) column[out] = std::move(column[i]);
+                ++out;
+            }
+            column.resize(out);
+        }
+
+    public:
+        SoAStorage() = default;
+
+        /**
+         * @brief Splits a record into its columns.
+         *
+         * @param value The record to append.
+         */
+        void push_back(const T& value) {
+            push_fields(value, std::make_index_sequence<field_count>());
+        }
+
+        /**
+         * @brief Reassembles the record at position i from all columns.
+         *
+         * @return T A copy of the record.
+         */
+        T get(size_t i) const {
+            return gather(i, std::make_index_sequence<field_count>());
+        }
+
+        /**
+         * @brief Returns the key of the record at position i without reassembling it.
+         */
+        const key_type& key(size_t i) const {
+            return std::get<0>(columns)[i];
+        }
+
+        /**
+         * @brief Returns the contiguous key column.
+         */
+        const std::vector<key_type>& keys() const {
+            return std::get<0>(columns);
+        }
+
+        /**
+         * @brief Removes every record equal to value.
+         *
+         * Candidates are filtered on the key column before records are reassembled.
+         * @return size_t Number of removed records.
+         */
+        size_t remove(const T& value) {
+            const key_type& needle = value.*std::get<0>(soa_traits<T>::fields);
+            std::vector<bool> keep(size(), true);
+            size_t removed = 0;
+            for (size_t i = 0; i < size(); ++i) {
+                if (key(i) == needle && get(i) == value) {
+                    keep[i] = false;
+                    ++removed;
+                }
+            }
+            if (removed > 0) {
+                compact(keep, std::make_index_sequence<field_count>());
+            }
+            return removed;
+        }
+
+        size_t size() const { return keys().size(); }
+        bool empty() const { return keys().empty(); }
+        allocator_type get_allocator() const { return allocator_type(); }
+    };
+
+    /**
+     * @brief MyContainer in structure-of-arrays mode.
+     *
+     * Sorted orders are computed on the key column alone and kept as a
+     * permutation of positions; records are reassembled only on dereference.
+     * The columns are held through a shared_ptr: iterators share the columns
+     * they were created from, and the first mutation while one is alive
+     * copies the columns instead of changing them under it.
+     */
+    template<typename T>
+    class MyContainer<T, SoAStorage<T>> {
+    public:
+        using value_type = T;
+        using storage_type = SoAStorage<T>;
+        using allocator_type = typename SoAStorage<T>::allocator_type;
+        using key_type = typename SoAStorage<T>::key_type;
+
+    private:
+        std::shared_ptr<SoAStorage<T>> data = std::make_shared<SoAStorage<T>>();///< Column storage for container elements
+
+        using permutation_type = std::vector<size_t>;
+
+        /**
+         * @brief How a traversal step maps onto a position of the columns or of the sorted permutation.
+         */
+        enum class Mapping { Forward, Backward, SideCross, MiddleOut };
+
+        /**
+         * @brief Sorts positions by key, ties broken by insertion position.
+         */
+        static permutation_type sorted_permutation(const SoAStorage<T>& source) {
+            const std::vector<key_type>& keys = source.keys();
+            std::vector<std::pair<key_type, size_t>> pairs;
+            pairs.reserve(keys.size());
+            for (size_t i = 0; i < keys.size(); ++i) {
+                pairs.emplace_back(keys[i], i);
+            }
+            std::sort(pairs.begin(), pairs.end());
+            permutation_type perm;
+            perm.reserve(pairs.size());
+            for (const auto& p : pairs) {
+                perm.push_back(p.second);
+            }
+            return perm;
+        }
+
+        /**
+         * @brief Returns the columns for mutation, copying them first if an iterator still shares them.
+         */
+        SoAStorage<T>& writable() {
+            if (data.use_count() > 1) {
+                data = std::make_shared<SoAStorage<T>>(*data);
+            }
+            return *data;
+        }
+
+    public:
+        /**
+         * @brief Iterator over a snapshot of the columns.
+         *
+         * Shares the columns it was created from and, for sorted orders, the
+         * ascending permutation, so it stays valid after the container is
+         * mutated or destroyed. Traversal steps are mapped onto positions with
+         * the same helpers as the default container; records are reassembled
+         * on dereference.
+         */
+        class PermutationIterator {
+            std::shared_ptr<const SoAStorage<T>> source;///< Column snapshot, null for the end sentinel
+            std::shared_ptr<const permutation_type> permutation;///< Ascending positions, null for insertion-based orders
+            Mapping mapping = Mapping::Forward;
+            size_t count = 0;
+            size_t index = 0;
+
+            friend class MyContainer;
+
+            PermutationIterator(std::shared_ptr<const SoAStorage<T>> source,
+                                std::shared_ptr<const permutation_type> permutation, Mapping mapping)
+                : source(std::move(source)), permutation(std::move(permutation)), mapping(mapping) {
+                count = this->source->size();
+            }
+
+            /**
+             * @brief Builds a past-the-end sentinel.
+             *
+             * Holds no snapshot and compares equal to any iterator that reached
+             * the end of its own snapshot. position() returns count.
+             * @param count Number of records at the time of the call.
+             */
+            static PermutationIterator end_of(size_t count) {
+                PermutationIterator it;
+                it.count = count;
+                it.index = count;
+                return it;
+            }
+
+        public:
+            PermutationIterator() = default;
+
+            /**
+             * @brief Reassembles the current record.
+             *
+             * @return T Copy of the current record.
+             * @throws std::out_of_range if attempting to dereference end().
+             */
+            T operator*() const {
+                return source->get(row());
+            }
+
+            /**
+             * @brief Returns the key of the current record without reassembling it.
+             *
+             * @throws std::out_of_range if attempting to dereference end().
+             */
+            const key_type& key() const {
+                return source->key(row());
+            }
+
+            /**
+             * @brief Returns the storage position of the current record in the snapshot.
+             *
+             * @throws std::out_of_range if attempting to dereference end().
+             */
+            size_t row() const {
+                if (!source || index >= count) {
+                    throw std::out_of_range("Dereferencing end() iterator");
+                }
+                size_t k = index;
+                switch (mapping) {
+                    case Mapping::Forward: break;
+                    case Mapping::Backward: k = count - 1 - index; break;
+                    case Mapping::SideCross: k = detail::side_cross_index(count, index); break;
+                    case Mapping::MiddleOut: k = detail::middle_out_index(count, index); break;
+                }
+                return permutation ? (*permutation)[k] : k;
+            }
+
+            PermutationIterator& operator++() {
+                ++index;
+                return *this;
+            }
+
+            /**
+             * @brief Equality comparison operator.
+             *
+             * The end sentinel equals any iterator at or past the end of its own snapshot.
+             */
+            bool operator==(const PermutationIterator& other) const {
+                if (source && !other.source) return index >= count;
+                if (!source && other.source) return other.index >= other.count;
+                return index == other.index;
+            }
+
+            bool operator!=(const PermutationIterator& other) const {
+                return !(*this == other);
+            }
+
+            size_t position() const {
+                return index;
+            }
+        };
+
+        using AscendingOrderIterator = PermutationIterator;
+        using DescendingOrderIterator = PermutationIterator;
+        using SideCrossOrderIterator = PermutationIterator;
+        using ReverseOrderIterator = PermutationIterator;
+        using OrderIterator = PermutationIterator;
+        using MiddleOutOrderIterator = PermutationIterator;
+
+    private:
+        /**
+         * @brief Starts a traversal of the sorted permutation of the current columns.
+         */
+        PermutationIterator sorted_begin(Mapping mapping) const {
+            auto perm = std::make_shared<const permutation_type>(sorted_permutation(*data));
+            return PermutationIterator(data, std::move(perm), mapping);
+        }
+
+    public:
+        /**
+         * @brief Default constructor.
+         */
+        MyContainer() = default;
+
+        /**
+         * @brief Copy constructor. Copies the columns; iterators of other keep theirs.
+         */
+        MyContainer(const MyContainer& other) : data(std::make_shared<SoAStorage<T>>(*other.data)) {}
+
+        /**
+         * @brief Copy assignment.
+         */
+        MyContainer& operator=(const MyContainer& other) {
+            if (this != &other) {
+                data = std::make_shared<SoAStorage<T>>(*other.data);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Adds a new record, splitting it into its columns.
+         *
+         * @param value The record to insert.
+         */
+        void addElement(const T& value) {
+            writable().push_back(value);
+        }
+
+        /**
+         * @brief Removes all occurrences of a given record from the container.
+         *
+         * @param value The record to remove.
+         * @throws std::runtime_error if the record is not found.
+         */
+        void remove(const T& value) {
+            if (writable().remove(value) == 0) {
+                throw std::runtime_error("Item not found in container");
+            }
+        }
+
+        /**
+         * @brief Returns the number of records in the container.
+         */
+        size_t size() const {
+            return data->size();
+        }
+
+        /**
+         * @brief Returns the column storage.
+         */
+        const SoAStorage<T>& get_data() const {
+            return *data;
+        }
+
+        allocator_type get_allocator() const {
+            return data->get_allocator();
+        }
+
+        /**
+         * @brief Iterator to the smallest key.
+         */
+        AscendingOrderIterator begin_ascending_order() const {
+            return sorted_begin(Mapping::Forward);
+        }
+
+        AscendingOrderIterator end_ascending_order() const {
+            return AscendingOrderIterator::end_of(size());
+        }
+
+        /**
+         * @brief Iterator to the largest key.
+         */
+        DescendingOrderIterator begin_descending_order() const {
+            return sorted_begin(Mapping::Backward);
+        }
+
+        DescendingOrderIterator end_descending_order() const {
+            return DescendingOrderIterator::end_of(size());
+        }
+
+        /**
+         * @brief Iterator over smallest, largest, 2nd smallest, 2nd largest key, etc.
+         */
+        SideCrossOrderIterator begin_side_cross_order() const {
+            return sorted_begin(Mapping::SideCross);
+        }
+
+        SideCrossOrderIterator end_side_cross_order() const {
+            return SideCrossOrderIterator::end_of(size());
+        }
+
+        /**
+         * @brief Iterator over reverse insertion order.
+         */
+        ReverseOrderIterator begin_reverse_order() const {
+            return ReverseOrderIterator(data, nullptr, Mapping::Backward);
+        }
+
+        ReverseOrderIterator end_reverse_order() const {
+            return ReverseOrderIterator::end_of(size());
+        }
+
+        /**
+         * @brief Iterator over insertion order.
+         */
+        OrderIterator begin_order() const {
+            return OrderIterator(data, nullptr, Mapping::Forward);
+        }
+
+        OrderIterator end_order() const {
+            return OrderIterator::end_of(size());
+        }
+
+        /**
+         * @brief Iterator from the middle record outward: right, left, right, left...
+         */
+        MiddleOutOrderIterator begin_middle_out_order() const {
+            return MiddleOutOrderIterator(data, nullptr, Mapping::MiddleOut);
+        }
+
+        MiddleOutOrderIterator end_middle_out_order() const {
+            return MiddleOutOrderIterator::end_of(size());
+        }
+    };
+
+}
@@ -0,0 +1,219 @@
+//fadinujedat062@gmail.com
+#pragma once
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+#include <unistd.h>
+
+namespace containers {
+    /**
+     * @brief Layout of a textual dump produced by write_to().
+     */
+    struct OutputFormat {
+        std::string_view prefix = "[";///< Written before the first element
+        std::string_view separator = ", ";///< Written between elements
+        std::string_view suffix = "]";///< Written after the last element
+        int precision = 6;///< Significant digits of floating-point elements
+
+        /**
+         * @brief One element per line, without brackets.
+         */
+        static OutputFormat lines() {
+            return OutputFormat{"", "\n", "\n", 6};
+        }
+    };
+
+    namespace detail {
+        /**
+         * @brief Bytes collected before the writer hands them to its sink.
+         */
+        constexpr size_t OUTPUT_BUFFER = 1 << 16;
+
+        inline std::string& output_buffer() {
+            thread_local std::string buffer;
+            return buffer;
+        }
+
+        /**
+         * @brief Sink writing to a POSIX file descriptor, retrying partial writes.
+         */
+        struct FdSink {
+            int fd;
+
+            void operator()(const char* p, size_t n) const {
+                while (n > 0) {
+                    ssize_t written = ::write(fd, p, n);
+                    if (written < 0) {
+                        if (errno == EINTR) continue;
+                        throw std::runtime_error("Failed to write output");
+                    }
+                    p += written;
+                    n -= static_cast<size_t>(written);
+                }
+            }
+        };
+
+        /**
+         * @brief Sink writing to a std::ostream; errors are reported through the stream state.
+         */
+        struct StreamSink {
+            std::ostream& os;
+
+            void operator()(const char* p, size_t n) const {
+                os.write(p, static_cast<std::streamsize>(n));
+            }
+        };
+
+        /**
+         * @brief Formats values into a large per-thread buffer and flushes it in big writes.
+         *
+         * Numbers are formatted with std::to_chars, without locale or stream
+         * state. The buffer is reused across calls on the same thread; a nested
+         * writer (e.g. from an element's own operator<<) gets a fresh one.
+         */
+        template<typename Sink>
+        class TextWriter {
+        private:
+            Sink sink;
+            std::string buffer;
+
+        public:
+            explicit TextWriter(Sink sink) : sink(sink) {
+                buffer.swap(output_buffer());
+                buffer.clear();
+                buffer.reserve(OUTPUT_BUFFER);
+            }
+
+            TextWriter(const TextWriter&) = delete;
+            TextWriter& operator=(const TextWriter&) = delete;
+
+            ~TextWriter() {
+                buffer.clear();
+                output_buffer().swap(buffer);
+            }
+
+            void append(std::string_view text) {
+                buffer.append(text);
+                if (buffer.size() >= OUTPUT_BUFFER) flush();
+            }
+
+            /**
+             * @brief Appends one value as text.
+             *
+             * Characters are written as characters, like operator<< does;
+             * floating-point values use the shortest of fixed and scientific
+             * notation with the given number of significant digits. Other types
+             * go through their operator<<, formatted like the target stream
+             * when writing to one, with the given precision.
+             */
+            template<typename T>
+            void value(const T& v, int precision) {
+                if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>) {
+                    buffer.push_back(static_cast<char>(v));
+                } else if constexpr (std::is_same_v<T, bool>) {
+                    buffer.push_back(v ? '1' : '0');
+                } else if constexpr (std::is_integral_v<T>) {
+                    char digits[24];
+                    auto result = std::to_chars(digits, digits + sizeof(digits), v);
+                    buffer.append(digits, result.ptr);
+                } else if constexpr (std::is_floating_point_v<T>) {
+                    char digits[64];
+                    auto result = std::to_chars(digits, digits + sizeof(digits), v, std::chars_format::general, precision);
+                    buffer.append(digits, result.ptr);
+                } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+                    buffer.append(std::string_view(v));
+                } else {
+                    std::ostringstream text;
+                    if constexpr (std::is_same_v<Sink, StreamSink>) {
+                        text.copyfmt(sink.os);
+                    }
+                    text.precision(precision);
+                    text << v;
+                    buffer.append(text.str());
+                }
+                if (buffer.size() >= OUTPUT_BUFFER) flush();
+            }
+
+            void flush() {
+                if (!buffer.empty()) {
+                    sink(buffer.data(), buffer.size());
+                    buffer.clear();
+                }
+            }
+        };
+
+        /**
+         * @brief True for the delimiter and ASCII whitespace, which all separate numbers.
+         */
+        inline bool is_separator(char c, char delimiter) {
+            return c == delimiter || c == ' ' || c == '\n' || c == '\r' || c == '\t';
+        }
+
+        /**
+         * @brief Bytes of text per chunk when parsing in parallel or pipelined.
+         */
+        constexpr size_t PARSE_CHUNK = 1 << 20;
+
+        /**
+         * @brief Cuts text into chunks that end on a separator.
+         *
+         * Chunk c covers [bounds[c], bounds[c + 1]); every bound but the
+         * first sits on a separator, so no number is cut in two.
+         * @param chunks Number of chunks, at least one.
+         */
+        inline std::vector<size_t> chunk_bounds(std::string_view text, size_t chunks, char delimiter) {
+            std::vector<size_t> bounds(chunks + 1, text.size());
+            bounds[0] = 0;
+            for (size_t c = 1; c < chunks; ++c) {
+                size_t b = std::max(bounds[c - 1], c * text.size() / chunks);
+                while (b < text.size() && !is_separator(text[b], delimiter)) ++b;
+                bounds[c] = b;
+            }
+            return bounds;
+        }
+
+        /**
+         * @brief Parses every number in [first, last) with std::from_chars and passes it to out.
+         *
+         * Runs of separators, including empty fields, are skipped.
+         * @param offset File offset of first, used in error messages.
+         * @throws std::runtime_error at the first token that is not a complete number of type T.
+         */
+        template<typename T, typename Out>
+        void parse_numbers(const char* first, const char* last, char delimiter, size_t offset, Out&& out) {
+            const char* p = first;
+            while (true) {
+                while (p != last && is_separator(*p, delimiter)) ++p;
+                if (p == last) return;
+                T value;
+                auto result = std::from_chars(p, last, value);
+                if (result.ec != std::errc() || (result.ptr != last && !is_separator(*result.ptr, delimiter))) {
+                    throw std::runtime_error("Invalid number at offset " + std::to_string(offset + static_cast<size_t>(p - first)));
+                }
+                out(value);
+                p = result.ptr;
+            }
+        }
+
+        /**
+         * @brief Estimates how many numbers text holds from the token density of its first 64 KiB.
+         */
+        inline size_t estimate_count(std::string_view text, char delimiter) {
+            const size_t sample = std::min<size_t>(text.size(), 1 << 16);
+            size_t tokens = 0;
+            for (size_t i = 0; i < sample; ++i) {
+                if (!is_separator(text[i], delimiter) && (i == 0 || is_separator(text[i - 1], delimiter))) ++tokens;
+            }
+            if (sample == text.size()) return tokens;
+            return static_cast<size_t>(static_cast<double>(tokens) * static_cast<double>(text.size()) / static_cast<double>(sample) * 1.05) + 16;
+        }
+    }
+}
@@ -0,0 +1,293 @@
+//fadinujedat062@gmail.com
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace containers {
+    /**
+     * @brief Fixed-size thread pool with per-worker deques and work stealing.
+     *
+     * Each worker pushes and pops tasks at the back of its own deque and, when
+     * it runs dry, steals from the front of the others. parallel_for splits a
+     * range recursively so that idle workers steal large halves first.
+     * Threads waiting for a parallel_for to finish run tasks themselves, so
+     * nested calls from inside a task do not deadlock.
+     */
+    class WorkStealingPool {
+    private:
+        using Task = std::function<void()>;
+
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues;///< One deque per worker
+        std::vector<std::thread> workers;
+        std::atomic<size_t> pending{0};///< Tasks pushed but not yet taken
+        std::atomic<size_t> next_queue{0};
+        std::mutex wake_mutex;
+        std::condition_variable wake;
+        bool stopping = false;
+
+        /**
+         * @brief Index of the calling thread's queue in this pool, or SIZE_MAX for outside threads.
+         */
+        size_t self_index() const {
+            return local_pool() == this ? local_index() : SIZE_MAX;
+        }
+
+        static const WorkStealingPool*& local_pool() {
+            thread_local const WorkStealingPool* pool = nullptr;
+            return pool;
+        }
+
+        static size_t& local_index() {
+            thread_local size_t index = 0;
+            return index;
+        }
+
+        void push(Task task) {
+            size_t self = self_index();
+            size_t q = self != SIZE_MAX ? self : next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+            {
+                std::lock_guard<std::mutex> lock(queues[q]->mutex);
+                queues[q]->tasks.push_back(std::move(task));
+            }
+            pending.fetch_add(1, std::memory_order_release);
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            wake.notify_one();
+        }
+
+        /**
+         * @brief Takes a task from the own deque's back, or steals from another deque's front.
+         */
+        bool try_take(size_t self, Task& out) {
+            if (pending.load(std::memory_order_acquire) == 0) {
+                return false;
+            }
+            if (self != SIZE_MAX) {
+                std::lock_guard<std::mutex> lock(queues[self]->mutex);
+                if (!queues[self]->tasks.empty()) {
+                    out = std::move(queues[self]->tasks.back());
+                    queues[self]->tasks.pop_back();
+                    pending.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            size_t start = self != SIZE_MAX ? self + 1 : 0;
+            for (size_t i = 0; i < queues.size(); ++i) {
+                Queue& victim = *queues[(start + i) % queues.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.tasks.empty()) {
+                    out = std::move(victim.tasks.front());
+                    victim.tasks.pop_front();
+                    pending.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void worker_loop(size_t index) {
+            local_pool() = this;
+            local_index() = index;
+            Task task;
+            while (true) {
+                if (try_take(index, task)) {
+                    task();
+                    task = nullptr;
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(wake_mutex);
+                wake.wait(lock, [this] { return stopping || pending.load(std::memory_order_acquire) > 0; });
+                if (stopping && pending.load(std::memory_order_acquire) == 0) {
+                    return;
+                }
+            }
+        }
+
+        /**
+         * @brief Completion state shared by the tasks of one parallel_for call.
+         */
+        struct Join {
+            std::atomic<size_t> outstanding{0};
+            std::mutex error_mutex;
+            std::exception_ptr error;
+        };
+
+        /**
+         * @brief Runs queued tasks on the calling thread until every task of join finished.
+         */
+        void help_until_done(const std::shared_ptr<Join>& join) {
+            size_t self = self_index();
+            Task task;
+            while (join->outstanding.load(std::memory_order_acquire) != 0) {
+                if (try_take(self, task)) {
+                    task();
+                    task = nullptr;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        template<typename Fn>
+        void split(size_t lo, size_t hi, size_t grain, Fn& fn, const std::shared_ptr<Join>& join) {
+            while (hi - lo > grain) {
+                size_t mid = lo + (hi - lo) / 2;
+                join->outstanding.fetch_add(1, std::memory_order_relaxed);
+                push([this, mid, hi, grain, &fn, join] { run_range(mid, hi, grain, fn, join); });
+                hi = mid;
+            }
+            fn(lo, hi);
+        }
+
+        template<typename Fn>
+        void run_range(size_t lo, size_t hi, size_t grain, Fn& fn, const std::shared_ptr<Join>& join) {
+            try {
+                split(lo, hi, grain, fn, join);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(join->error_mutex);
+                if (!join->error) join->error = std::current_exception();
+            }
+            join->outstanding.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+    public:
+        /**
+         * @brief Starts a pool with the given number of workers.
+         *
+         * @param threads Number of worker threads, at least one.
+         */
+        explicit WorkStealingPool(size_t threads = std::thread::hardware_concurrency()) {
+            if (threads == 0) threads = 1;
+            for (size_t i = 0; i < threads; ++i) {
+                queues.push_back(std::make_unique<Queue>());
+            }
+            for (size_t i = 0; i < threads; ++i) {
+                workers.emplace_back([this, i] { worker_loop(i); });
+            }
+        }
+
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        /**
+         * @brief Finishes all queued tasks and joins the workers.
+         */
+        ~WorkStealingPool() {
+            {
+                std::lock_guard<std::mutex> lock(wake_mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+
+        /**
+         * @brief Returns the process-wide pool sized to the hardware concurrency.
+         */
+        static WorkStealingPool& instance() {
+            static WorkStealingPool pool;
+            return pool;
+        }
+
+        /**
+         * @brief Returns the number of worker threads.
+         */
+        size_t size() const {
+            return workers.size();
+        }
+
+        /**
+         * @brief Calls fn(lo, hi) on disjoint sub-ranges covering [begin, end) in parallel.
+         *
+         * Sub-ranges hold at most grain indices. Returns when every call finished;
+         * the calling thread executes tasks while waiting. The first exception
+         * thrown by fn is rethrown here.
+         * @param begin First index.
+         * @param end One past the last index.
+         * @param grain Maximum sub-range length, at least one.
+         * @param fn Callable taking (size_t lo, size_t hi).
+         */
+        template<typename Fn>
+        void parallel_for(size_t begin, size_t end, size_t grain, Fn&& fn) {
+            if (begin >= end) return;
+            if (grain == 0) grain = 1;
+            auto join = std::make_shared<Join>();
+            join->outstanding.store(1, std::memory_order_relaxed);
+            run_range(begin, end, grain, fn, join);
+            help_until_done(join);
+            if (join->error) {
+                std::rethrow_exception(join->error);
+            }
+        }
+
+        /**
+         * @brief Set of independent tasks started one at a time and joined together.
+         *
+         * Lets a producer hand work to the pool as it becomes available, e.g.
+         * one task per parsed chunk. wait() runs queued tasks on the calling
+         * thread like parallel_for does; the destructor waits as well, so the
+         * tasks may reference locals declared before the group.
+         */
+        class TaskGroup {
+        private:
+            WorkStealingPool& pool;
+            std::shared_ptr<Join> join = std::make_shared<Join>();
+
+        public:
+            explicit TaskGroup(WorkStealingPool& pool) : pool(pool) {}
+
+            TaskGroup(const TaskGroup&) = delete;
+            TaskGroup& operator=(const TaskGroup&) = delete;
+
+            ~TaskGroup() {
+                pool.help_until_done(join);
+            }
+
+            /**
+             * @brief Queues fn() on the pool.
+             *
+             * @param fn Copyable callable; an exception it throws is rethrown by wait().
+             */
+            template<typename Fn>
+            void run(Fn fn) {
+                join->outstanding.fetch_add(1, std::memory_order_relaxed);
+                pool.push([join = join, fn]() mutable {
+                    try {
+                        fn();
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(join->error_mutex);
+                        if (!join->error) join->error = std::current_exception();
+                    }
+                    join->outstanding.fetch_sub(1, std::memory_order_acq_rel);
+                });
+            }
+
+            /**
+             * @brief Returns when every queued task finished.
+             *
+             * @throws The first exception thrown by a task.
+             */
+            void wait() {
+                pool.help_until_done(join);
+                if (join->error) {
+                    std::rethrow_exception(std::exchange(join->error, nullptr));
+                }
+            }
+        };
+    };
+
+}
@@ -0,0 +1,289 @@
+//fadinujedat062@gmail.com
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "MyContainer.hpp"
+#include "ChunkedStorage.hpp"
+#include "ConcurrentMyContainer.hpp"
+using namespace containers;
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Log2 latency histogram in nanoseconds.
+ *
+ * Bucket i counts samples in [2^i, 2^(i+1)) ns.
+ */
+struct LatencyHistogram {
+    static constexpr size_t BUCKETS = 40;
+    size_t buckets[BUCKETS] = {};
+    size_t samples = 0;
+    long long max_ns = 0;
+
+    void record(long long ns) {
+        size_t b = 0;
+        while (b + 1 < BUCKETS && (1LL << (b + 1)) <= ns) ++b;
+        ++buckets[b];
+        ++samples;
+        if (ns > max_ns) max_ns = ns;
+    }
+
+    /**
+     * @brief Returns the upper bound of the bucket holding the given percentile.
+     */
+    long long percentile(double p) const {
+        size_t target = static_cast<size_t>(p * samples);
+        size_t seen = 0;
+        for (size_t b = 0; b < BUCKETS; ++b) {
+            seen += buckets[b];
+            if (seen > target) return 1LL << (b + 1);
+        }
+        return max_ns;
+    }
+
+    void print(const std::string& title) const {
+        std::cout << "\n==== " << title << " ====" << std::endl;
+        std::cout << "p50 < " << percentile(0.50) << " ns, p99 < " << percentile(0.99)
+                  << " ns, p99.9 < " << percentile(0.999) << " ns, max = " << max_ns << " ns" << std::endl;
+        for (size_t b = 0; b < BUCKETS; ++b) {
+            if (buckets[b] == 0) continue;
+            std::cout << std::setw(12) << (1LL << b) << " ns  " << std::setw(12) << buckets[b] << std::endl;
+        }
+    }
+};
+
+/**
+ * @brief Measures the latency of every addElement call on a fresh container.
+ */
+template<typename Container>
+LatencyHistogram bench_add_latency(size_t n) {
+    Container c;
+    LatencyHistogram hist;
+    for (size_t i = 0; i < n; ++i) {
+        auto start = Clock::now();
+        c.addElement(static_cast<int>(i));
+        auto stop = Clock::now();
+        hist.record(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+    }
+    return hist;
+}
+
+/**
+ * @brief Runs fn(thread_index, count) on the given number of threads and returns the elapsed seconds.
+ */
+template<typename Fn>
+double run_threads(size_t threads, size_t per_thread, Fn fn) {
+    std::vector<std::thread> workers;
+    auto start = Clock::now();
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back(fn, t, per_thread);
+    }
+    for (auto& w : workers) w.join();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Compares multi-producer insertion throughput of a mutex-wrapped
+ * MyContainer against ConcurrentMyContainer for 1 to 64 threads.
+ */
+void bench_concurrent_insert(size_t total) {
+    std::cout << "\n==== Concurrent insertion, " << total << " inserts total (Mops/s) ====" << std::endl;
+    std::cout << std::setw(8) << "threads" << std::setw(16) << "mutex" << std::setw(16) << "concurrent" << std::endl;
+    for (size_t threads = 1; threads <= 64; threads *= 2) {
+        size_t per_thread = total / threads;
+
+        MyContainer<int> locked;
+        std::mutex lock;
+        double mutex_s = run_threads(threads, per_thread, [&](size_t t, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                std::lock_guard<std::mutex> guard(lock);
+                locked.addElement(static_cast<int>(t + i));
+            }
+        });
+
+        ConcurrentMyContainer<int> concurrent;
+        double concurrent_s = run_threads(threads, per_thread, [&](size_t t, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                concurrent.addElement(static_cast<int>(t + i));
+            }
+        });
+
+        double ops = static_cast<double>(per_thread * threads) / 1e6;
+        std::cout << std::setw(8) << threads << std::setw(16) << std::fixed << std::setprecision(1)
+                  << ops / mutex_s << std::setw(16) << ops / concurrent_s << std::endl;
+    }
+}
+
+/**
+ * @brief Deterministic, well-spread test values for each benchmarked element type.
+ */
+template<typename T>
+T make_value(size_t i) {
+    long long v = static_cast<long long>((i * 2654435761ULL) % 1000000007ULL);
+    if constexpr (std::is_same_v<T, std::string>) {
+        return "value-" + std::to_string(v);
+    } else {
+        return static_cast<T>(v) / static_cast<T>(7);
+    }
+}
+
+/**
+ * @brief Folds a value into the checksum that keeps traversals from being optimized away.
+ */
+template<typename T>
+size_t weigh(const T& value) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        return value.size();
+    } else {
+        return static_cast<size_t>(value);
+    }
+}
+
+volatile size_t bench_sink = 0;
+
+/**
+ * @brief Prints one result row as ns/element and millions of elements per second.
+ */
+void report(const std::string& type, size_t n, const std::string& operation, double seconds, size_t elements) {
+    double ns = seconds * 1e9 / static_cast<double>(elements);
+    std::cout << std::setw(12) << type << std::setw(12) << n << std::setw(32) << operation
+              << std::setw(14) << std::fixed << std::setprecision(2) << ns
+              << std::setw(14) << std::setprecision(2) << 1e3 / ns << std::endl;
+}
+
+/**
+ * @brief Repetitions that make one measurement cover about a million elements.
+ */
+size_t repetitions(size_t n) {
+    return std::max<size_t>(1, 1000000 / n);
+}
+
+/**
+ * @brief Measures one traversal order on cold copies of c.
+ *
+ * "begin+end" times the first begin/end pair on a cold cache, which builds
+ * the ordering; "traverse" times a full pass over the now cached ordering.
+ */
+template<typename T, typename Begin, typename End>
+void bench_order(const MyContainer<T>& c, const std::string& type, const std::string& name, Begin begin, End end) {
+    const size_t n = c.size();
+    const size_t reps = repetitions(n);
+    double open_s = 0;
+    double walk_s = 0;
+    size_t sum = 0;
+    for (size_t r = 0; r < reps; ++r) {
+        MyContainer<T> cold(c);
+        auto start = Clock::now();
+        auto it = begin(cold);
+        auto last = end(cold);
+        auto opened = Clock::now();
+        for (; it != last; ++it) {
+            sum += weigh(*it);
+        }
+        auto stop = Clock::now();
+        open_s += std::chrono::duration<double>(opened - start).count();
+        walk_s += std::chrono::duration<double>(stop - opened).count();
+    }
+    bench_sink = bench_sink + sum;
+    report(type, n, name + " begin+end", open_s, n * reps);
+    report(type, n, name + " traverse", walk_s, n * reps);
+}
+
+/**
+ * @brief Measures addElement, remove and every traversal order for one element type and size.
+ */
+template<typename T>
+void bench_suite(const std::string& type, size_t n) {
+    const size_t reps = repetitions(n);
+    MyContainer<T> c;
+    double add_s = 0;
+    for (size_t r = 0; r < reps; ++r) {
+        MyContainer<T> fresh;
+        auto start = Clock::now();
+        for (size_t i = 0; i < n; ++i) {
+            fresh.addElement(make_value<T>(i));
+        }
+        add_s += std::chrono::duration<double>(Clock::now() - start).count();
+        if (r + 1 == reps) c = std::move(fresh);
+    }
+    report(type, n, "addElement", add_s, n * reps);
+
+    bench_order(c, type, "ascending", [](const MyContainer<T>& m) { return m.begin_ascending_order(); },
+                [](const MyContainer<T>& m) { return m.end_ascending_order(); });
+    bench_order(c, type, "descending", [](const MyContainer<T>& m) { return m.begin_descending_order(); },
+                [](const MyContainer<T>& m) { return m.end_descending_order(); });
+    bench_order(c, type, "side-cross", [](const MyContainer<T>& m) { return m.begin_side_cross_order(); },
+                [](const MyContainer<T>& m) { return m.end_side_cross_order(); });
+    bench_order(c, type, "reverse", [](const MyContainer<T>& m) { return m.begin_reverse_order(); },
+                [](const MyContainer<T>& m) { return m.end_reverse_order(); });
+    bench_order(c, type, "insertion", [](const MyContainer<T>& m) { return m.begin_order(); },
+                [](const MyContainer<T>& m) { return m.end_order(); });
+    bench_order(c, type, "middle-out", [](const MyContainer<T>& m) { return m.begin_middle_out_order(); },
+                [](const MyContainer<T>& m) { return m.end_middle_out_order(); });
+
+    // remove scans the whole storage, so a bounded number of calls is timed
+    // and reported per element scanned.
+    const size_t removals = std::min<size_t>(n, 100);
+    auto start = Clock::now();
+    for (size_t i = 0; i < removals; ++i) {
+        c.remove(make_value<T>(i));
+    }
+    double remove_s = std::chrono::duration<double>(Clock::now() - start).count();
+    report(type, n, "remove (per element scanned)", remove_s, removals * n);
+}
+
+/**
+ * @brief Runs the suite for int, double and std::string at sizes 1e2 up to max_size.
+ */
+void bench_all(size_t max_size) {
+    std::cout << "\n==== Operations, sizes 1e2 to " << max_size << " ====" << std::endl;
+    std::cout << std::setw(12) << "type" << std::setw(12) << "n" << std::setw(32) << "operation"
+              << std::setw(14) << "ns/element" << std::setw(14) << "Melem/s" << std::endl;
+    for (size_t n = 100; n <= max_size; n *= 10) {
+        bench_suite<int>("int", n);
+        bench_suite<double>("double", n);
+        bench_suite<std::string>("std::string", n);
+    }
+}
+
+/**
+ * @brief Usage: run_bench [--max-size N] [--latency N] [--suite-only].
+ *
+ * --max-size bounds the operation suite (default 1e6; 1e8 needs several
+ * GiB for std::string), --latency sets the insert count of the latency
+ * and concurrency sections (default 1e7).
+ */
+int main(int argc, char* argv[]) {
+    size_t max_size = 1000000;
+    size_t n = 10000000;
+    bool suite_only = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--max-size") == 0 && i + 1 < argc) {
+            max_size = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--latency") == 0 && i + 1 < argc) {
+            n = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--suite-only") == 0) {
+            suite_only = true;
+        } else {
+            std::cerr << "usage: " << argv[0] << " [--max-size N] [--latency N] [--suite-only]" << std::endl;
+            return 1;
+        }
+    }
+
+    bench_all(max_size);
+    if (suite_only) return 0;
+
+    std::cout << "\naddElement latency, " << n << " inserts" << std::endl;
+    bench_add_latency<MyContainer<int>>(n).print("std::vector storage");
+    bench_add_latency<MyContainer<int, ChunkedStorage<int>>>(n).print("ChunkedStorage");
+    bench_concurrent_insert(std::min<size_t>(n, 4000000));
+    return 0;
+}
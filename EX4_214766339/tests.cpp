@@ -1,9 +1,43 @@
 //fadinujedat062@gmail.com
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define MYCONTAINER_STATS
+#include <thread>
 #include "doctest.h"
 #include "MyContainer.hpp"
+#include "ChunkedStorage.hpp"
+#include "SoAStorage.hpp"
+#include "RunLengthStorage.hpp"
+#include "ConcurrentMyContainer.hpp"
+#include "KWayMerge.hpp"
+#include "EpochMyContainer.hpp"
+#include "MappedMyContainer.hpp"
+#include "MyContainerView.hpp"
+#include <numeric>
+#include <filesystem>
+#include <complex>
+#include <iomanip>
+#include <optional>
+#include <csignal>
+#include <sys/resource.h>
 using namespace containers;
 
+/**
+ * @brief Record type used by the structure-of-arrays tests.
+ */
+struct Trade {
+    double price = 0;
+    int qty = 0;
+    std::string id;
+    bool operator==(const Trade& other) const {
+        return price == other.price && qty == other.qty && id == other.id;
+    }
+};
+
+template<>
+struct containers::soa_traits<Trade> {
+    static constexpr auto fields = std::make_tuple(&Trade::price, &Trade::qty, &Trade::id);
+};
+
 /**
  * @brief Test basic insertion and container size.
  * 
@@ -498,3 +532,1875 @@ TEST_CASE("Test long strings lexicographic order") {
     }
 }
 
+
+/**
+ * @brief Test container backed by a std::pmr::memory_resource.
+ * 
+ * Verifies that the storage and the iterator ordering buffers
+ * allocate from the supplied resource instead of the global heap.
+ */
+TEST_CASE("Test pmr container allocates from resource") {
+    struct CountingResource : std::pmr::memory_resource {
+        size_t allocations = 0;
+        void* do_allocate(size_t bytes, size_t align) override {
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, align);
+        }
+        void do_deallocate(void* p, size_t bytes, size_t align) override {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    } resource;
+
+    pmr::MyContainer<int> c(&resource);
+    c.addElement(3);
+    c.addElement(1);
+    c.addElement(2);
+    size_t after_insert = resource.allocations;
+    CHECK(after_insert > 0);
+
+    std::vector<int> expected = {1, 2, 3};
+    size_t i = 0;
+    for (auto it = c.begin_ascending_order(); it != c.end_ascending_order(); ++it) {
+        CHECK(*it == expected[i++]);
+    }
+    CHECK(resource.allocations > after_insert);
+    CHECK(c.get_allocator().resource() == &resource);
+}
+
+/**
+ * @brief Test pmr container inside a monotonic arena.
+ * 
+ * Ensures all traversal orders work when every allocation comes
+ * from a std::pmr::monotonic_buffer_resource.
+ */
+TEST_CASE("Test pmr container with monotonic arena") {
+    char buffer[4096];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    pmr::MyContainer<int> c(&arena);
+    c.addElement(7);
+    c.addElement(15);
+    c.addElement(6);
+    std::vector<int> expected = {15, 7, 6};
+    size_t i = 0;
+    for (auto it = c.begin_descending_order(); it != c.end_descending_order(); ++it) {
+        CHECK(*it == expected[i++]);
+    }
+    CHECK(*c.begin_side_cross_order() == 6);
+    CHECK(*c.begin_middle_out_order() == 15);
+}
+
+/**
+ * @brief Test container with chunked storage.
+ * 
+ * Inserts across several chunks and verifies that traversal orders
+ * and removal behave exactly as with the default vector storage.
+ */
+TEST_CASE("Test chunked storage container") {
+    MyContainer<int, ChunkedStorage<int, 4>> c;
+    for (int v : {9, 3, 7, 1, 5, 3, 8, 2, 6, 4}) {
+        c.addElement(v);
+    }
+    CHECK(c.size() == 10);
+    std::vector<int> expected = {1, 2, 3, 3, 4, 5, 6, 7, 8, 9};
+    size_t i = 0;
+    for (auto it = c.begin_ascending_order(); it != c.end_ascending_order(); ++it) {
+        CHECK(*it == expected[i++]);
+    }
+    c.remove(3);
+    expected = {9, 7, 1, 5, 8, 2, 6, 4};
+    i = 0;
+    for (auto it = c.begin_order(); it != c.end_order(); ++it) {
+        CHECK(*it == expected[i++]);
+    }
+}
+
+/**
+ * @brief Test that chunked storage never relocates existing elements.
+ * 
+ * Takes the address of the first element and checks it is unchanged
+ * after many appends that span multiple chunks.
+ */
+TEST_CASE("Test chunked storage keeps element addresses stable") {
+    ChunkedStorage<std::string, 8> storage;
+    storage.push_back("first");
+    const std::string* first = &storage[0];
+    for (int i = 0; i < 100; ++i) {
+        storage.push_back(std::to_string(i));
+    }
+    CHECK(&storage[0] == first);
+    CHECK(storage[0] == "first");
+    CHECK(storage.back() == "99");
+    CHECK_THROWS_AS(storage.at(101), std::out_of_range);
+}
+
+/**
+ * @brief Test that a failed chunk index growth does not leak the new chunk.
+ * 
+ * The resource refuses the index reallocation; the chunk allocated just
+ * before must be returned and the storage left unchanged.
+ */
+TEST_CASE("Test chunked storage releases chunk when index growth fails") {
+    struct FailingResource : std::pmr::memory_resource {
+        size_t outstanding = 0;
+        bool fail_index = false;
+        void* do_allocate(size_t bytes, size_t align) override {
+            if (fail_index && align == alignof(int*)) {
+                throw std::bad_alloc();
+            }
+            outstanding += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, align);
+        }
+        void do_deallocate(void* p, size_t bytes, size_t align) override {
+            outstanding -= bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    } resource;
+    {
+        ChunkedStorage<int, 4, std::pmr::polymorphic_allocator<int>> storage{std::pmr::polymorphic_allocator<int>(&resource)};
+        for (int i = 0; i < 4; ++i) {
+            storage.push_back(i);
+        }
+        size_t held = resource.outstanding;
+        resource.fail_index = true;
+        CHECK_THROWS_AS(storage.push_back(4), std::bad_alloc);
+        CHECK(resource.outstanding == held);
+        CHECK(storage.size() == 4);
+        resource.fail_index = false;
+        storage.push_back(4);
+        CHECK(storage.back() == 4);
+    }
+    CHECK(resource.outstanding == 0);
+}
+
+/**
+ * @brief Test structure-of-arrays container ordering by key.
+ * 
+ * Verifies that sorted orders follow the key column and that records
+ * are reassembled with all of their fields on dereference.
+ */
+TEST_CASE("Test SoA container orders by key") {
+    MyContainer<Trade, SoAStorage<Trade>> c;
+    c.addElement({3.5, 10, "c"});
+    c.addElement({1.25, 20, "a"});
+    c.addElement({2.0, 30, "b"});
+    CHECK(c.size() == 3);
+    CHECK(c.get_data().keys() == std::vector<double>{3.5, 1.25, 2.0});
+
+    std::vector<std::string> expected = {"a", "b", "c"};
+    size_t i = 0;
+    for (auto it = c.begin_ascending_order(); it != c.end_ascending_order(); ++it) {
+        CHECK((*it).id == expected[i++]);
+    }
+    auto desc = c.begin_descending_order();
+    CHECK(desc.key() == 3.5);
+    CHECK((*desc).qty == 10);
+
+    expected = {"a", "c", "b"};
+    i = 0;
+    for (auto it = c.begin_side_cross_order(); it != c.end_side_cross_order(); ++it) {
+        CHECK((*it).id == expected[i++]);
+    }
+    CHECK((*c.begin_middle_out_order()).id == "a");
+    CHECK((*c.begin_reverse_order()).id == "b");
+}
+
+/**
+ * @brief Test removal from a structure-of-arrays container.
+ * 
+ * Ensures removal deletes every equal record from all columns and
+ * throws when no record matches.
+ */
+TEST_CASE("Test SoA container remove") {
+    MyContainer<Trade, SoAStorage<Trade>> c;
+    c.addElement({1.0, 1, "x"});
+    c.addElement({2.0, 2, "y"});
+    c.addElement({1.0, 1, "x"});
+    c.remove({1.0, 1, "x"});
+    CHECK(c.size() == 1);
+    CHECK((*c.begin_order()).id == "y");
+    CHECK_THROWS_AS(c.remove({1.0, 2, "x"}), std::runtime_error);
+    CHECK(c.begin_order() != c.end_order());
+}
+
+/**
+ * @brief Test structure-of-arrays iterators over a snapshot.
+ *
+ * Ensures iterators keep traversing the records they were created from
+ * after the container is mutated or destroyed, and stop at their own end.
+ */
+TEST_CASE("Test SoA iterators survive mutation") {
+    auto walk = [](auto it, auto end) {
+        std::vector<std::string> ids;
+        for (; it != end; ++it) ids.push_back((*it).id);
+        return ids;
+    };
+    std::optional<MyContainer<Trade, SoAStorage<Trade>>> c(std::in_place);
+    c->addElement({3.0, 1, "c"});
+    c->addElement({1.0, 2, "a"});
+    c->addElement({2.0, 3, "b"});
+    c->addElement({4.0, 4, "d"});
+
+    auto asc = c->begin_ascending_order();
+    auto side = c->begin_side_cross_order();
+    auto middle = c->begin_middle_out_order();
+    auto order = c->begin_order();
+    c->remove({1.0, 2, "a"});
+    c->addElement({0.5, 5, "z"});
+    CHECK(walk(c->begin_order(), c->end_order()) == std::vector<std::string>{"c", "b", "d", "z"});
+
+    auto end = c->end_order();
+    c.reset();
+    CHECK(walk(asc, end) == std::vector<std::string>{"a", "b", "c", "d"});
+    CHECK(walk(side, end) == std::vector<std::string>{"a", "d", "b", "c"});
+    CHECK(walk(middle, end) == std::vector<std::string>{"b", "d", "a", "c"});
+    CHECK(walk(order, end) == std::vector<std::string>{"c", "a", "b", "d"});
+    CHECK_THROWS_AS(*end, std::out_of_range);
+}
+
+/**
+ * @brief Test run-length container with duplicates.
+ * 
+ * Verifies that duplicate-heavy input is stored as distinct runs while
+ * ascending, descending and side-cross orders expand every occurrence.
+ */
+TEST_CASE("Test run-length container expands duplicates") {
+    MyContainer<float, RunLengthStorage<float>> c;
+    for (float v : {2.2f, 1.1f, 2.2f, 3.3f, 2.2f, 1.1f}) {
+        c.addElement(v);
+    }
+    CHECK(c.size() == 6);
+    CHECK(c.get_data().distinct() == 3);
+    CHECK(c.get_data().count(2.2f) == 3);
+
+    std::vector<float> expected = {1.1f, 1.1f, 2.2f, 2.2f, 2.2f, 3.3f};
+    size_t i = 0;
+    for (auto it = c.begin_ascending_order(); it != c.end_ascending_order(); ++it) {
+        CHECK(doctest::Approx(*it) == expected[i++]);
+    }
+    CHECK(i == 6);
+
+    expected = {3.3f, 2.2f, 2.2f, 2.2f, 1.1f, 1.1f};
+    i = 0;
+    for (auto it = c.begin_descending_order(); it != c.end_descending_order(); ++it) {
+        CHECK(doctest::Approx(*it) == expected[i++]);
+    }
+
+    expected = {1.1f, 3.3f, 1.1f, 2.2f, 2.2f, 2.2f};
+    i = 0;
+    for (auto it = c.begin_side_cross_order(); it != c.end_side_cross_order(); ++it) {
+        CHECK(doctest::Approx(*it) == expected[i++]);
+    }
+}
+
+/**
+ * @brief Test run-length container removal.
+ * 
+ * Ensures remove() drops a whole run at once and throws on a missing value.
+ */
+TEST_CASE("Test run-length container remove") {
+    MyContainer<int, RunLengthStorage<int>> c;
+    for (int v : {7, 3, 7, 1, 7}) {
+        c.addElement(v);
+    }
+    c.remove(7);
+    CHECK(c.size() == 2);
+    CHECK(c.get_data().distinct() == 2);
+    CHECK_THROWS_AS(c.remove(7), std::runtime_error);
+    CHECK(*c.begin_ascending_order() == 1);
+}
+
+/**
+ * @brief Test run-length orders match the default container on distinct values.
+ * 
+ * Compares every traversal order against MyContainer<int> for sizes 0..9.
+ */
+TEST_CASE("Test run-length orders match vector storage") {
+    for (int n = 0; n < 10; ++n) {
+        MyContainer<int> plain;
+        MyContainer<int, RunLengthStorage<int>> runs;
+        for (int v = 0; v < n; ++v) {
+            int value = (v * 7) % 10;
+            plain.addElement(value);
+            runs.addElement(value);
+        }
+        auto a = plain.begin_side_cross_order();
+        for (auto it = runs.begin_side_cross_order(); it != runs.end_side_cross_order(); ++it, ++a) {
+            CHECK(*it == *a);
+        }
+        auto b = plain.begin_middle_out_order();
+        for (auto it = runs.begin_middle_out_order(); it != runs.end_middle_out_order(); ++it, ++b) {
+            CHECK(*it == *b);
+        }
+        auto r = plain.begin_reverse_order();
+        for (auto it = runs.begin_reverse_order(); it != runs.end_reverse_order(); ++it, ++r) {
+            CHECK(*it == *r);
+        }
+    }
+}
+
+/**
+ * @brief Test concurrent insertion from several threads.
+ * 
+ * Each thread inserts its own range; the snapshot must contain every
+ * element, and each thread's elements must keep their insertion order.
+ */
+TEST_CASE("Test concurrent container snapshot") {
+    ConcurrentMyContainer<int> c;
+    const int threads = 4;
+    const int per_thread = 2000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&c, t] {
+            for (int i = 0; i < per_thread; ++i) {
+                c.addElement(t * per_thread + i);
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    CHECK(c.size() == threads * per_thread);
+    CHECK(c.shard_count() == threads);
+    MyContainer<int> snap = c.snapshot();
+    CHECK(snap.size() == threads * per_thread);
+
+    std::vector<int> last(threads, -1);
+    auto end = snap.end_order();
+    for (auto it = snap.begin_order(); it != end; ++it) {
+        int t = *it / per_thread;
+        CHECK(*it > last[t]);
+        last[t] = *it;
+    }
+    int expected = 0;
+    bool sorted = true;
+    auto end_ascending = snap.end_ascending_order();
+    for (auto it = snap.begin_ascending_order(); it != end_ascending; ++it) {
+        sorted = sorted && (*it == expected++);
+    }
+    CHECK(sorted);
+}
+
+/**
+ * @brief Test snapshot of a concurrent container with strings.
+ * 
+ * Ensures non-trivial element types are copied into and out of
+ * the per-thread buffers correctly.
+ */
+TEST_CASE("Test concurrent container with strings") {
+    ConcurrentMyContainer<std::string> c;
+    c.addElement("beta");
+    c.addElement("alpha");
+    MyContainer<std::string> snap = c.snapshot();
+    CHECK(snap.size() == 2);
+    CHECK(*snap.begin_ascending_order() == "alpha");
+    CHECK(*snap.begin_order() == "beta");
+}
+
+/**
+ * @brief Test a concurrent container of over-aligned elements.
+ * 
+ * Thread buffer segments must honour alignof(T) beyond the default new
+ * alignment; a snapshot across several segments keeps insertion order.
+ */
+TEST_CASE("Test concurrent container with over-aligned elements") {
+    struct alignas(32) Wide {
+        int value;
+        bool operator==(const Wide& other) const { return value == other.value; }
+    };
+    ConcurrentMyContainer<Wide> c;
+    for (int i = 0; i < 3000; ++i) {
+        c.addElement(Wide{2999 - i});
+    }
+    MyContainer<Wide> snap = c.snapshot();
+    CHECK(snap.size() == 3000);
+    CHECK(reinterpret_cast<uintptr_t>(&snap.get_data()[0]) % alignof(Wide) == 0);
+    CHECK((*snap.begin_order()).value == 2999);
+    CHECK((*snap.begin_reverse_order()).value == 0);
+}
+
+/**
+ * @brief Test epoch-based reclamation of published versions.
+ * 
+ * A pinned version must survive later publications and be
+ * reclaimed only after its reader leaves.
+ */
+TEST_CASE("Test epoch container keeps pinned versions alive") {
+    EpochMyContainer<int> c;
+    c.addElement(3);
+    c.addElement(1);
+    CHECK(c.publish() == 1);
+    {
+        auto guard = c.read();
+        CHECK(guard->number == 1);
+        CHECK(guard.ascending() == std::vector<int>{1, 3});
+
+        c.addElement(2);
+        c.publish();
+        c.publish();
+        CHECK(c.retired_count() >= 1);
+        CHECK(guard.ascending() == std::vector<int>{1, 3});
+        CHECK(guard.elements().size() == 2);
+    }
+    c.publish();
+    CHECK(c.retired_count() == 0);
+
+    auto latest = c.read();
+    CHECK(latest.ascending() == std::vector<int>{1, 2, 3});
+    CHECK(latest.elements().front() == 3);
+}
+
+/**
+ * @brief Test that publications merge changes into the ascending order.
+ * 
+ * Adds, removes and re-adds between publications must give the same
+ * orders as a freshly sorted MyContainer, for all six traversals.
+ */
+TEST_CASE("Test epoch container merges published changes") {
+    EpochMyContainer<int> c;
+    MyContainer<int> reference;
+    auto both_add = [&](int v) { c.addElement(v); reference.addElement(v); };
+    auto both_remove = [&](int v) { c.remove(v); reference.remove(v); };
+    for (int v : {5, 1, 4, 1, 9}) both_add(v);
+    c.publish();
+    both_add(3);
+    both_remove(1);
+    both_add(7);
+    both_add(1);
+    both_remove(9);
+    both_add(4);
+    c.publish();
+    c.publish();
+
+    auto walk = [](auto it, auto end) {
+        std::vector<int> out;
+        for (; it != end; ++it) out.push_back(*it);
+        return out;
+    };
+    auto guard = c.read();
+    auto collect = [&](Order order) {
+        std::vector<int> out;
+        guard->for_each(order, [&](const int& v) { out.push_back(v); });
+        return out;
+    };
+    CHECK(guard.ascending() == walk(reference.begin_ascending_order(), reference.end_ascending_order()));
+    CHECK(collect(Order::Ascending) == walk(reference.begin_ascending_order(), reference.end_ascending_order()));
+    CHECK(collect(Order::Descending) == walk(reference.begin_descending_order(), reference.end_descending_order()));
+    CHECK(collect(Order::SideCross) == walk(reference.begin_side_cross_order(), reference.end_side_cross_order()));
+    CHECK(collect(Order::Reverse) == walk(reference.begin_reverse_order(), reference.end_reverse_order()));
+    CHECK(collect(Order::Insertion) == walk(reference.begin_order(), reference.end_order()));
+    CHECK(collect(Order::MiddleOut) == walk(reference.begin_middle_out_order(), reference.end_middle_out_order()));
+}
+
+/**
+ * @brief Test concurrent readers with a publishing writer.
+ * 
+ * Readers must always observe a complete, sorted version whose size
+ * matches its publication number.
+ */
+TEST_CASE("Test epoch container with concurrent readers") {
+    EpochMyContainer<int> c;
+    std::atomic<bool> done{false};
+    std::atomic<bool> consistent{true};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                auto guard = c.read();
+                const auto& asc = guard.ascending();
+                if (asc.size() != guard->number || !std::is_sorted(asc.begin(), asc.end())) {
+                    consistent = false;
+                }
+            }
+        });
+    }
+    for (int i = 0; i < 200; ++i) {
+        c.addElement(200 - i);
+        c.publish();
+    }
+    done = true;
+    for (auto& r : readers) r.join();
+    CHECK(consistent.load());
+    c.publish();
+    CHECK(c.retired_count() == 0);
+}
+
+/**
+ * @brief Test parallel_for_each over a traversal order.
+ * 
+ * Every element must be visited exactly once, whatever the order.
+ */
+TEST_CASE("Test parallel_for_each visits every element") {
+    MyContainer<int> c;
+    for (int i = 0; i < 10000; ++i) {
+        c.addElement(i);
+    }
+    std::vector<std::atomic<int>> visits(10000);
+    c.parallel_for_each(Order::MiddleOut, [&](const int& v) { visits[v]++; }, 64);
+    bool once = true;
+    for (auto& v : visits) {
+        once = once && v.load() == 1;
+    }
+    CHECK(once);
+}
+
+/**
+ * @brief Test parallel_transform_reduce with an order-sensitive reduction.
+ * 
+ * String concatenation is not commutative, so the result reveals
+ * whether chunk results are combined in traversal order.
+ */
+TEST_CASE("Test parallel_transform_reduce keeps traversal order") {
+    MyContainer<int> c;
+    for (int v : {5, 3, 8, 1, 9, 2, 7}) {
+        c.addElement(v);
+    }
+    auto concat = [](const std::string& a, const std::string& b) { return a + b; };
+    auto to_string = [](const int& v) { return std::to_string(v); };
+    CHECK(c.parallel_transform_reduce(Order::Ascending, std::string(">"), concat, to_string, 2) == ">1235789");
+    CHECK(c.parallel_transform_reduce(Order::SideCross, std::string(), concat, to_string, 3) == "1928375");
+
+    MyContainer<int> empty;
+    CHECK(empty.parallel_transform_reduce(Order::Insertion, 42, std::plus<int>(), [](const int& v) { return v; }) == 42);
+}
+
+/**
+ * @brief Test that exceptions thrown in parallel_for_each reach the caller.
+ */
+TEST_CASE("Test parallel_for_each propagates exceptions") {
+    MyContainer<int> c;
+    for (int i = 0; i < 100; ++i) {
+        c.addElement(i);
+    }
+    CHECK_THROWS_AS(c.parallel_for_each(Order::Insertion, [](const int& v) {
+        if (v == 57) throw std::runtime_error("bad element");
+    }, 8), std::runtime_error);
+}
+
+/**
+ * @brief Test built-in reductions on doubles.
+ * 
+ * Checks sum, min, max, mean and count_if, and that parallel
+ * execution reproduces the sequential sum exactly.
+ */
+TEST_CASE("Test reductions on doubles") {
+    MyContainer<double> c;
+    std::vector<double> values;
+    for (int i = 0; i < 20000; ++i) {
+        double v = (i % 97) * 0.1 - 3.3;
+        values.push_back(v);
+        c.addElement(v);
+    }
+    double expected = std::accumulate(values.begin(), values.end(), 0.0);
+    CHECK(c.sum() == doctest::Approx(expected));
+    CHECK(c.sum(Execution::Parallel) == c.sum(Execution::Sequential));
+    CHECK(c.min() == doctest::Approx(-3.3));
+    CHECK(c.max(Execution::Parallel) == doctest::Approx(6.3));
+    CHECK(c.mean() == doctest::Approx(expected / 20000));
+    CHECK(c.count_if([](double v) { return v < 0; }, Execution::Parallel) ==
+          static_cast<size_t>(std::count_if(values.begin(), values.end(), [](double v) { return v < 0; })));
+}
+
+/**
+ * @brief Test deterministic summation order.
+ * 
+ * The dispatched kernel (AVX2 where available) must match the portable
+ * 16-lane order bit for bit, so Summation::Deterministic gives the same
+ * result on every target and in both execution modes.
+ */
+TEST_CASE("Test deterministic sums") {
+    std::vector<double> d;
+    std::vector<float> f;
+    for (int i = 0; i < 10007; ++i) {
+        d.push_back((i % 3 == 0 ? 1e16 : 1.0) * ((i % 7) - 3) + i * 1e-3);
+        f.push_back(static_cast<float>((i % 5 == 0 ? 1e7 : 0.5) * ((i % 11) - 5)));
+    }
+    for (size_t n : {size_t(0), size_t(7), size_t(16), size_t(33), size_t(4096), d.size()}) {
+        CHECK(detail::sum_kernel(d.data(), n, true) == detail::sum_lanes(d.data(), n));
+        CHECK(detail::sum_kernel(f.data(), n, true) == detail::sum_lanes(f.data(), n));
+    }
+
+    MyContainer<double> c{std::vector<double>(d)};
+    double expected = 0.0;
+    for (size_t lo = 0; lo < d.size(); lo += detail::REDUCTION_BLOCK) {
+        expected += detail::sum_lanes(d.data() + lo, std::min(detail::REDUCTION_BLOCK, d.size() - lo));
+    }
+    CHECK(c.sum(Execution::Sequential, Summation::Deterministic) == expected);
+    CHECK(c.sum(Execution::Parallel, Summation::Deterministic) == expected);
+    CHECK(c.mean(Execution::Sequential, Summation::Deterministic) == expected / static_cast<double>(d.size()));
+}
+
+/**
+ * @brief Test NaN and signed-zero semantics of min and max.
+ * 
+ * A NaN anywhere makes both results NaN, and -0 orders below +0, on the
+ * SIMD kernel and the scalar fallback alike.
+ */
+TEST_CASE("Test min and max with NaN and signed zeros") {
+    for (size_t at : {size_t(0), size_t(5), size_t(20), size_t(36)}) {
+        std::vector<double> d(37, 1.5);
+        d[3] = -2.0;
+        d[at] = std::numeric_limits<double>::quiet_NaN();
+        std::vector<float> f(d.begin(), d.end());
+        CHECK(std::isnan(detail::min_max_kernel(d.data(), d.size()).first));
+        CHECK(std::isnan(detail::min_max_kernel(d.data(), d.size()).second));
+        CHECK(std::isnan(detail::min_max_scalar(d.data(), d.size()).first));
+        CHECK(std::isnan(detail::min_max_kernel(f.data(), f.size()).second));
+        CHECK(std::isnan(detail::min_max_scalar(f.data(), f.size()).second));
+        MyContainer<double> c{std::move(d)};
+        CHECK(std::isnan(c.min()));
+        CHECK(std::isnan(c.max(Execution::Parallel)));
+    }
+
+    std::vector<double> zeros(21, 0.0);
+    zeros[13] = -0.0;
+    std::vector<double> negative_zeros(21, -0.0);
+    negative_zeros[9] = 0.0;
+    for (const auto* v : {&zeros, &negative_zeros}) {
+        auto simd = detail::min_max_kernel(v->data(), v->size());
+        auto scalar = detail::min_max_scalar(v->data(), v->size());
+        CHECK(std::signbit(simd.first));
+        CHECK_FALSE(std::signbit(simd.second));
+        CHECK(std::signbit(scalar.first));
+        CHECK_FALSE(std::signbit(scalar.second));
+    }
+    std::vector<float> fzeros(zeros.begin(), zeros.end());
+    CHECK(std::signbit(detail::min_max_kernel(fzeros.data(), fzeros.size()).first));
+    CHECK_FALSE(std::signbit(detail::min_max_kernel(fzeros.data(), fzeros.size()).second));
+}
+
+/**
+ * @brief Test reductions on integers, chunked storage and empty containers.
+ * 
+ * Integer sums accumulate in 64 bits; min/max/mean throw when empty.
+ */
+TEST_CASE("Test reductions on integers and empty containers") {
+    MyContainer<int, ChunkedStorage<int, 16>> c;
+    for (int i = 1; i <= 100; ++i) {
+        c.addElement(i * 20000000);
+    }
+    CHECK(c.sum() == 5050LL * 20000000);
+    CHECK(c.min() == 20000000);
+    CHECK(c.max() == 100 * 20000000);
+
+    MyContainer<float> empty;
+    CHECK(empty.sum() == 0.0f);
+    CHECK(empty.count_if([](float) { return true; }) == 0);
+    CHECK_THROWS_AS(empty.min(), std::runtime_error);
+    CHECK_THROWS_AS(empty.mean(), std::runtime_error);
+}
+
+/**
+ * @brief Test splitting an iterator into balanced sub-ranges.
+ * 
+ * The sub-ranges must be disjoint, cover the traversal in order and
+ * differ in length by at most one.
+ */
+TEST_CASE("Test iterator split into balanced ranges") {
+    MyContainer<int> c;
+    for (int v : {9, 4, 7, 1, 8, 2, 6, 3, 5, 0}) {
+        c.addElement(v);
+    }
+    auto ranges = c.begin_ascending_order().split(3);
+    REQUIRE(ranges.size() == 3);
+    CHECK(ranges[0].size() == 4);
+    CHECK(ranges[1].size() == 3);
+    CHECK(ranges[2].size() == 3);
+
+    int expected = 0;
+    for (const auto& range : ranges) {
+        for (int v : range) {
+            CHECK(v == expected++);
+        }
+    }
+    CHECK(expected == 10);
+    CHECK(ranges[2].end() == c.end_ascending_order());
+    CHECK(c.begin_order().split(20).size() == 20);
+    CHECK_THROWS_AS(c.begin_order().split(0), std::invalid_argument);
+}
+
+/**
+ * @brief Test recursive splitting for fork-join processing.
+ * 
+ * Splitting a sub-range again must stay within that sub-range.
+ */
+TEST_CASE("Test recursive iterator split") {
+    MyContainer<int> c;
+    for (int i = 0; i < 100; ++i) {
+        c.addElement(i);
+    }
+    auto halves = c.begin_middle_out_order().split(2);
+    auto quarters = halves[1].split(2);
+    CHECK(quarters[0].begin().position() == 50);
+    CHECK(quarters[0].size() == 25);
+    CHECK(quarters[1].end().position() == 100);
+
+    std::vector<int> expected;
+    for (auto it = c.begin_middle_out_order(); it != c.end_middle_out_order(); ++it) {
+        expected.push_back(*it);
+    }
+    std::vector<int> visited;
+    for (const auto& half : halves) {
+        for (const auto& part : half.split(3)) {
+            for (int v : part) visited.push_back(v);
+        }
+    }
+    CHECK(visited == expected);
+}
+
+/**
+ * @brief Test that iterator ranges keep their ordering after the container changes.
+ * 
+ * Split ranges share one ordering snapshot taken when the iterator was created.
+ */
+TEST_CASE("Test split ranges outlive container changes") {
+    MyContainer<int> c;
+    c.addElement(2);
+    c.addElement(1);
+    auto ranges = c.begin_descending_order().split(2);
+    c.addElement(3);
+    c.remove(1);
+    CHECK(*ranges[0].begin() == 2);
+    CHECK(*ranges[1].begin() == 1);
+}
+
+/**
+ * @brief Test loser-tree merge of sorted runs.
+ * 
+ * Runs of different lengths, including empty ones and duplicates,
+ * must merge into one sorted sequence.
+ */
+TEST_CASE("Test multiway merge with loser tree") {
+    std::vector<std::vector<int>> data = {{1, 4, 9}, {}, {2, 2, 8, 10}, {0}, {3, 5, 6, 7}};
+    std::vector<SortedRun<int>> runs;
+    for (const auto& run : data) {
+        runs.emplace_back(run.data(), run.data() + run.size());
+    }
+    std::vector<int> out;
+    multiway_merge(runs, std::back_inserter(out));
+    CHECK(out == std::vector<int>{0, 1, 2, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+
+    std::vector<int> parallel;
+    parallel_multiway_merge(runs, parallel);
+    CHECK(parallel == out);
+}
+
+/**
+ * @brief Test parallel merge with splitter partitioning on larger runs.
+ */
+TEST_CASE("Test parallel multiway merge on large runs") {
+    WorkStealingPool pool(4);
+    std::vector<std::vector<int>> data(7);
+    for (int i = 0; i < 70000; ++i) {
+        data[i % 7].push_back((i * 7919) % 10007);
+    }
+    std::vector<int> expected;
+    std::vector<SortedRun<int>> runs;
+    for (auto& run : data) {
+        std::sort(run.begin(), run.end());
+        expected.insert(expected.end(), run.begin(), run.end());
+        runs.emplace_back(run.data(), run.data() + run.size());
+    }
+    std::sort(expected.begin(), expected.end());
+    std::vector<int> out;
+    parallel_multiway_merge(runs, out, pool);
+    CHECK(out == expected);
+}
+
+/**
+ * @brief Test ascending traversal of a concurrent container.
+ * 
+ * The ascending iterator must come from per-shard sorts and a merge
+ * and visit every inserted element in order.
+ */
+TEST_CASE("Test concurrent container ascending order") {
+    ConcurrentMyContainer<int> c;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 3; ++t) {
+        workers.emplace_back([&c, t] {
+            for (int i = 0; i < 3000; ++i) {
+                c.addElement((i * 31 + t) % 1000);
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    std::vector<int> seen;
+    auto end = c.end_ascending_order();
+    for (auto it = c.begin_ascending_order(); it != end; ++it) {
+        seen.push_back(*it);
+    }
+    CHECK(seen.size() == 9000);
+    CHECK(std::is_sorted(seen.begin(), seen.end()));
+}
+
+/**
+ * @brief Test coroutine streams against the iterator orders.
+ * 
+ * Every stream_* generator must yield exactly the sequence of the
+ * matching begin_*_order() traversal.
+ */
+TEST_CASE("Test streams match iterator orders") {
+    MyContainer<int> c;
+    for (int v : {7, 15, 6, 1, 2, 6}) {
+        c.addElement(v);
+    }
+    auto collect = [](auto&& gen) {
+        std::vector<int> out;
+        for (const int& v : gen) out.push_back(v);
+        return out;
+    };
+    auto walk = [](auto it, auto end) {
+        std::vector<int> out;
+        for (; it != end; ++it) out.push_back(*it);
+        return out;
+    };
+    CHECK(collect(c.stream_ascending()) == walk(c.begin_ascending_order(), c.end_ascending_order()));
+    CHECK(collect(c.stream_descending()) == walk(c.begin_descending_order(), c.end_descending_order()));
+    CHECK(collect(c.stream_side_cross()) == walk(c.begin_side_cross_order(), c.end_side_cross_order()));
+    CHECK(collect(c.stream_reverse()) == walk(c.begin_reverse_order(), c.end_reverse_order()));
+    CHECK(collect(c.stream_order()) == walk(c.begin_order(), c.end_order()));
+    CHECK(collect(c.stream_middle_out()) == walk(c.begin_middle_out_order(), c.end_middle_out_order()));
+}
+
+/**
+ * @brief Test that streams are lazy and handle empty containers.
+ * 
+ * Taking the first element of a stream must not require consuming the rest.
+ */
+TEST_CASE("Test streams are lazy") {
+    MyContainer<std::string> c;
+    for (auto s : {"pear", "apple", "fig"}) {
+        c.addElement(s);
+    }
+    auto gen = c.stream_ascending();
+    auto it = gen.begin();
+    CHECK(*it == "apple");
+    ++it;
+    CHECK(*it == "fig");
+
+    MyContainer<int> empty;
+    auto none = empty.stream_middle_out();
+    CHECK(none.begin() == none.end());
+}
+
+/**
+ * @brief Test the background pre-sorting worker.
+ * 
+ * After a burst of insertions settles, the sorted orderings are published
+ * without any reader asking; a reader arriving right after a mutation
+ * waits for the worker and still sees the new contents.
+ */
+TEST_CASE("Test background presort warms ordering cache") {
+    auto walk = [](auto it, auto end) {
+        std::vector<int> out;
+        for (; it != end; ++it) out.push_back(*it);
+        return out;
+    };
+    MyContainer<int> c;
+    c.enable_background_presort(std::chrono::milliseconds(1));
+    CHECK(c.background_presort_enabled());
+    for (int v : {9, 3, 7, 1, 5}) {
+        c.addElement(v);
+    }
+    for (int i = 0; i < 2000 && !c.has_cached_ordering(Order::SideCross); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(c.has_cached_ordering(Order::Ascending));
+    CHECK(c.has_cached_ordering(Order::Descending));
+    CHECK(c.has_cached_ordering(Order::SideCross));
+
+    c.addElement(4);
+    CHECK_FALSE(c.has_cached_ordering(Order::Ascending));
+    std::vector<int> ascending = walk(c.begin_ascending_order(), c.end_ascending_order());
+    CHECK(ascending == std::vector<int>({1, 3, 4, 5, 7, 9}));
+    std::vector<int> crossed = walk(c.begin_side_cross_order(), c.end_side_cross_order());
+    CHECK(crossed == std::vector<int>({1, 9, 3, 7, 4, 5}));
+
+    c.remove(9);
+    std::vector<int> descending = walk(c.begin_descending_order(), c.end_descending_order());
+    CHECK(descending == std::vector<int>({7, 5, 4, 3, 1}));
+
+    MyContainer<int> copy = c;
+    CHECK_FALSE(copy.background_presort_enabled());
+    c.disable_background_presort();
+    CHECK_FALSE(c.background_presort_enabled());
+}
+
+/**
+ * @brief Test single-flight ordering construction.
+ * 
+ * Concurrent readers of an unchanged container must all share one ordering
+ * buffer; a mutation makes the next reader build a fresh one.
+ */
+TEST_CASE("Test concurrent readers share one ordering") {
+    MyContainer<int> c;
+    for (int i = 0; i < 50000; ++i) {
+        c.addElement((i * 7919) % 50000);
+    }
+    const int readers = 8;
+    std::vector<const int*> firsts(readers, nullptr);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < readers; ++t) {
+        threads.emplace_back([&c, &firsts, t] {
+            firsts[t] = &*c.begin_ascending_order();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (int t = 0; t < readers; ++t) {
+        CHECK(firsts[t] == firsts[0]);
+    }
+    CHECK(*firsts[0] == 0);
+    CHECK(c.has_cached_ordering(Order::Ascending));
+
+    auto begin = c.begin_middle_out_order();
+    CHECK(&*begin == &*c.begin_middle_out_order());
+    CHECK(c.end_middle_out_order().position() == c.size());
+
+    c.addElement(-1);
+    CHECK_FALSE(c.has_cached_ordering(Order::Ascending));
+    CHECK(*c.begin_ascending_order() == -1);
+    CHECK(&*begin != &*c.begin_middle_out_order());
+}
+
+/**
+ * @brief Test binary snapshot round trips.
+ * 
+ * Numbers, strings and chunked storage must come back element for element.
+ */
+TEST_CASE("Test save and load snapshots") {
+    std::string path = (std::filesystem::temp_directory_path() / "mycontainer_snapshot_test.bin").string();
+
+    MyContainer<double> numbers;
+    for (int i = 0; i < 10000; ++i) {
+        numbers.addElement(i * 0.5 - 7);
+    }
+    numbers.save(path);
+    MyContainer<double> loaded_numbers;
+    loaded_numbers.addElement(42);
+    loaded_numbers.load(path);
+    CHECK(loaded_numbers.get_data() == numbers.get_data());
+    CHECK(*loaded_numbers.begin_ascending_order() == -7);
+
+    MyContainer<int, ChunkedStorage<int, 64>> chunked;
+    for (int i = 0; i < 1000; ++i) {
+        chunked.addElement(i * 3);
+    }
+    chunked.save(path);
+    MyContainer<int> flat;
+    flat.load(path);
+    CHECK(flat.size() == 1000);
+    CHECK(flat.get_data()[999] == 2997);
+    MyContainer<int, ChunkedStorage<int, 64>> chunked_back;
+    chunked_back.load(path);
+    CHECK(chunked_back.size() == 1000);
+    CHECK(chunked_back.get_data()[500] == 1500);
+
+    MyContainer<std::string> words;
+    for (auto w : {"", "alpha", "a longer string that does not fit in SSO", "z"}) {
+        words.addElement(w);
+    }
+    words.save(path);
+    MyContainer<std::string> loaded_words;
+    loaded_words.load(path);
+    CHECK(loaded_words.get_data() == words.get_data());
+    std::filesystem::remove(path);
+}
+
+/**
+ * @brief Test that invalid snapshots are rejected.
+ * 
+ * A wrong element type, a corrupted payload or a truncated file must throw
+ * and leave the target container unchanged.
+ */
+TEST_CASE("Test load rejects invalid snapshots") {
+    std::string path = (std::filesystem::temp_directory_path() / "mycontainer_snapshot_bad.bin").string();
+    MyContainer<int> c;
+    for (int i = 0; i < 100; ++i) {
+        c.addElement(i);
+    }
+    c.save(path);
+
+    MyContainer<double> wrong_type;
+    CHECK_THROWS_AS(wrong_type.load(path), std::runtime_error);
+
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(sizeof(snapshot::Header) + 10);
+        file.put('\x7f');
+    }
+    MyContainer<int> target;
+    target.addElement(5);
+    CHECK_THROWS_WITH(target.load(path), "Snapshot checksum mismatch");
+    CHECK(target.size() == 1);
+
+    std::filesystem::resize_file(path, sizeof(snapshot::Header) + 16);
+    CHECK_THROWS_AS(target.load(path), std::runtime_error);
+    CHECK_THROWS_AS(target.load(path + ".missing"), std::runtime_error);
+    CHECK(target.size() == 1);
+    std::filesystem::remove(path);
+}
+
+/**
+ * @brief Test that a mapped snapshot traverses like the container it was saved from.
+ * 
+ * Covers all six orders, with the permutation stored in the file and built lazily.
+ */
+TEST_CASE("Test mapped snapshot orders") {
+    std::string path = (std::filesystem::temp_directory_path() / "mycontainer_mapped_test.bin").string();
+    MyContainer<int> c;
+    for (int v : {7, 15, 6, 1, 2, 6, 9}) {
+        c.addElement(v);
+    }
+    auto walk = [](auto it, auto end) {
+        std::vector<int> out;
+        for (; it != end; ++it) out.push_back(*it);
+        return out;
+    };
+    for (bool with_permutation : {false, true}) {
+        c.save(path, with_permutation);
+        MappedMyContainer<int> mapped(path);
+        CHECK(mapped.has_stored_permutation() == with_permutation);
+        CHECK(mapped.size() == c.size());
+        CHECK_NOTHROW(mapped.verify());
+        CHECK(walk(mapped.begin_ascending_order(), mapped.end_ascending_order()) ==
+              walk(c.begin_ascending_order(), c.end_ascending_order()));
+        CHECK(walk(mapped.begin_descending_order(), mapped.end_descending_order()) ==
+              walk(c.begin_descending_order(), c.end_descending_order()));
+        CHECK(walk(mapped.begin_side_cross_order(), mapped.end_side_cross_order()) ==
+              walk(c.begin_side_cross_order(), c.end_side_cross_order()));
+        CHECK(walk(mapped.begin_reverse_order(), mapped.end_reverse_order()) ==
+              walk(c.begin_reverse_order(), c.end_reverse_order()));
+        CHECK(walk(mapped.begin_order(), mapped.end_order()) == walk(c.begin_order(), c.end_order()));
+        CHECK(walk(mapped.begin_middle_out_order(), mapped.end_middle_out_order()) ==
+              walk(c.begin_middle_out_order(), c.end_middle_out_order()));
+        CHECK_THROWS_AS(*mapped.end_order(), std::out_of_range);
+    }
+
+    MyContainer<int> loaded;
+    loaded.load(path);
+    CHECK(loaded.get_data() == c.get_data());
+    CHECK_THROWS_AS(MappedMyContainer<double>{path}, std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+/**
+ * @brief Test buffered formatted output.
+ * 
+ * operator<< keeps its format; write_to dumps any order to a stream or a
+ * file descriptor, also when the output exceeds the internal buffer.
+ */
+TEST_CASE("Test write_to formatted output") {
+    MyContainer<double> d;
+    for (double v : {3.5, -0.25, 1e21, 2.0 / 3.0}) {
+        d.addElement(v);
+    }
+    std::ostringstream expected;
+    expected << "[3.5, -0.25, " << 1e21 << ", " << 2.0 / 3.0 << "]";
+    std::ostringstream printed;
+    printed << d;
+    CHECK(printed.str() == expected.str());
+
+    MyContainer<char> chars;
+    chars.addElement('b');
+    chars.addElement('a');
+    std::ostringstream sorted_chars;
+    chars.write_to(sorted_chars, Order::Ascending, OutputFormat{"<", "|", ">", 6});
+    CHECK(sorted_chars.str() == "<a|b>");
+
+    MyContainer<int> big;
+    std::string lines;
+    for (int i = 0; i < 50000; ++i) {
+        big.addElement(49999 - i);
+        lines += std::to_string(i) + "\n";
+    }
+    std::string path = (std::filesystem::temp_directory_path() / "mycontainer_write_to.txt").string();
+    {
+        std::ofstream file(path);
+        big.write_to(file, Order::Ascending, OutputFormat::lines());
+    }
+    std::ifstream back(path);
+    std::string content((std::istreambuf_iterator<char>(back)), std::istreambuf_iterator<char>());
+    CHECK(content == lines);
+
+    int fd = ::open(path.c_str(), O_WRONLY | O_TRUNC);
+    REQUIRE(fd >= 0);
+    big.write_to(fd, Order::Descending, OutputFormat::lines());
+    ::close(fd);
+    std::ifstream back_fd(path);
+    std::string first;
+    std::getline(back_fd, first);
+    CHECK(first == "49999");
+    std::filesystem::remove(path);
+}
+
+/**
+ * @brief Test parsing numbers from text buffers and files.
+ * 
+ * Delimiters may be mixed with whitespace and CRLF line ends; invalid
+ * tokens are reported with their offset.
+ */
+TEST_CASE("Test parse_from text") {
+    auto csv = MyContainer<int>::parse_from_buffer("3, -1,7,,42\r\n", ',');
+    CHECK(csv.get_data() == std::vector<int>({3, -1, 7, 42}));
+
+    auto lines = MyContainer<double>::parse_from_buffer("1.5\n-2e3\n\n0.25");
+    CHECK(lines.get_data() == std::vector<double>({1.5, -2000, 0.25}));
+
+    CHECK(MyContainer<int>::parse_from_buffer("").size() == 0);
+    CHECK_THROWS_WITH(MyContainer<int>::parse_from_buffer("1\n2x\n3"), "Invalid number at offset 2");
+    CHECK_THROWS_AS(MyContainer<int>::parse_from_buffer("1,2", ';'), std::runtime_error);
+    CHECK_THROWS_AS(MyContainer<int>::parse_from("/nonexistent/numbers.txt"), std::runtime_error);
+}
+
+/**
+ * @brief Test that parallel file parsing matches sequential parsing.
+ * 
+ * The input spans several chunks, so chunk boundaries land inside numbers.
+ */
+TEST_CASE("Test parallel parse_from file") {
+    std::string path = (std::filesystem::temp_directory_path() / "mycontainer_parse_test.txt").string();
+    MyContainer<long long> source;
+    for (long long i = 0; i < 400000; ++i) {
+        source.addElement((i * 2654435761LL) % 1000003 - 500000);
+    }
+    {
+        std::ofstream file(path);
+        source.write_to(file, Order::Insertion, OutputFormat::lines());
+    }
+    auto sequential = MyContainer<long long>::parse_from(path);
+    auto parallel = MyContainer<long long>::parse_from(path, '\n', Execution::Parallel);
+    CHECK(sequential.get_data() == source.get_data());
+    CHECK(parallel.get_data() == source.get_data());
+    std::filesystem::remove(path);
+}
+
+/**
+ * @brief Test external sorting under a small memory budget.
+ * 
+ * The budget forces many spilled runs; both merged traversals must match
+ * the in-memory orders, duplicates included. Incrementing past the end throws.
+ */
+TEST_CASE("Test external sort streams merged runs") {
+    MyContainer<int> c;
+    for (int i = 0; i < 20000; ++i) {
+        c.addElement((i * 7919) % 5003);
+    }
+    auto sorter = c.external_sort(4096);
+    CHECK(sorter.size() == c.size());
+    CHECK(sorter.run_count() == 20);
+
+    std::vector<int> expected(c.get_data().begin(), c.get_data().end());
+    std::sort(expected.begin(), expected.end());
+    std::vector<int> ascending;
+    for (auto it = sorter.begin_ascending_order(), end = sorter.end_ascending_order(); it != end; ++it) {
+        ascending.push_back(*it);
+    }
+    CHECK(ascending == expected);
+
+    std::vector<int> descending;
+    for (auto it = sorter.begin_descending_order(), end = sorter.end_descending_order(); it != end; ++it) {
+        descending.push_back(*it);
+    }
+    std::reverse(expected.begin(), expected.end());
+    CHECK(descending == expected);
+
+    std::string path = (std::filesystem::temp_directory_path() / "mycontainer_external_test.bin").string();
+    c.save(path);
+    {
+        MappedMyContainer<int> mapped(path);
+        auto mapped_sorter = mapped.external_sort(8192);
+        CHECK(mapped_sorter.run_count() == 10);
+        CHECK(*mapped_sorter.begin_ascending_order() == 0);
+        CHECK(*mapped_sorter.begin_descending_order() == 5002);
+    }
+    std::filesystem::remove(path);
+
+    MyContainer<int> empty;
+    auto none = empty.external_sort(4096);
+    CHECK(none.run_count() == 0);
+    CHECK(none.begin_ascending_order() == none.end_ascending_order());
+    auto past = sorter.end_ascending_order();
+    CHECK_THROWS_AS(++past, std::out_of_range);
+    CHECK_THROWS_AS(++none.begin_descending_order(), std::out_of_range);
+    CHECK_THROWS_AS(++decltype(past){}, std::out_of_range);
+    CHECK_THROWS_AS(c.external_sort(2), std::invalid_argument);
+}
+
+/**
+ * @brief Test external sort merge passes and move semantics.
+ * 
+ * A tiny budget produces hundreds of runs; they are merged in passes so at
+ * most MAX_FAN_IN stay open, and the sorter can be moved into an optional.
+ */
+TEST_CASE("Test external sort bounds open runs and moves") {
+    std::vector<int> input(100000);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<int>((i * 7919) % 40009);
+    }
+    ExternalSort<int> sorter(input.begin(), input.end(), 1024);
+    CHECK(sorter.size() == input.size());
+    CHECK(sorter.run_count() <= ExternalSort<int>::MAX_FAN_IN);
+
+    std::optional<ExternalSort<int>> held;
+    held.emplace(std::move(sorter));
+    CHECK(sorter.size() == 0);
+    CHECK(sorter.run_count() == 0);
+    CHECK(sorter.begin_ascending_order() == sorter.end_ascending_order());
+
+    std::vector<int> expected = input;
+    std::sort(expected.begin(), expected.end());
+    std::vector<int> ascending;
+    for (auto it = held->begin_ascending_order(), end = held->end_ascending_order(); it != end; ++it) {
+        ascending.push_back(*it);
+    }
+    CHECK(ascending == expected);
+
+    ExternalSort<int> other(expected.begin(), expected.begin() + 10, 1024);
+    other = std::move(*held);
+    CHECK(held->run_count() == 0);
+    std::vector<int> descending;
+    for (auto it = other.begin_descending_order(), end = other.end_descending_order(); it != end; ++it) {
+        descending.push_back(*it);
+    }
+    std::reverse(expected.begin(), expected.end());
+    CHECK(descending == expected);
+}
+
+/**
+ * @brief Test recovery from snapshot plus operation log.
+ * 
+ * Mutations after a checkpoint are replayed on reopen; a torn record at
+ * the end of the log is dropped.
+ */
+TEST_CASE("Test persistent container recovers after restart") {
+    std::string dir = (std::filesystem::temp_directory_path() / "mycontainer_persist_test").string();
+    std::filesystem::remove_all(dir);
+    {
+        MyContainer<int> c;
+        c.addElement(1);
+        c.open_persistent(dir);
+        CHECK(c.is_persistent());
+        c.addElement(2);
+        c.addElement(3);
+        c.checkpoint();
+        c.addElement(4);
+        c.remove(2);
+        c.addElement(2);
+        CHECK_THROWS_AS(c.remove(99), std::runtime_error);
+        c.sync();
+    }
+    {
+        std::ofstream torn(dir + "/log.2", std::ios::binary | std::ios::app);
+        torn.write("\x01\x04\x00", 3);
+    }
+    MyContainer<int> restarted;
+    restarted.addElement(42);
+    restarted.open_persistent(dir);
+    CHECK(restarted.get_data() == std::vector<int>({1, 3, 4, 2}));
+    restarted.addElement(5);
+    restarted.close_persistent();
+
+    MyContainer<int> again;
+    again.open_persistent(dir);
+    CHECK(again.get_data() == std::vector<int>({1, 3, 4, 2, 5}));
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief Test that failed log writes and failed mutations leave no record behind.
+ * 
+ * A file size limit cuts a record off mid-write; the torn bytes must be
+ * removed so the records appended afterwards survive a restart.
+ */
+TEST_CASE("Test operation log recovers from failed appends") {
+    std::string dir = (std::filesystem::temp_directory_path() / "mycontainer_persist_torn").string();
+    std::filesystem::remove_all(dir);
+    {
+        MyContainer<std::string> c;
+        c.open_persistent(dir);
+        c.addElement("a");
+        CHECK_THROWS_AS(c.remove("missing"), std::runtime_error);
+
+        struct rlimit saved;
+        getrlimit(RLIMIT_FSIZE, &saved);
+        auto previous = std::signal(SIGXFSZ, SIG_IGN);
+        struct rlimit limited = saved;
+        limited.rlim_cur = 1024;
+        setrlimit(RLIMIT_FSIZE, &limited);
+        CHECK_THROWS_AS(c.addElement(std::string(4096, 'x')), std::runtime_error);
+        setrlimit(RLIMIT_FSIZE, &saved);
+        std::signal(SIGXFSZ, previous);
+
+        CHECK(c.size() == 1);
+        c.addElement("b");
+    }
+    MyContainer<std::string> reopened;
+    reopened.open_persistent(dir);
+    CHECK(reopened.get_data() == std::vector<std::string>({"a", "b"}));
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief Test automatic checkpoints of a persistent string container.
+ * 
+ * Every few mutations a new snapshot generation replaces the old files.
+ */
+TEST_CASE("Test persistent container checkpoints periodically") {
+    std::string dir = (std::filesystem::temp_directory_path() / "mycontainer_persist_auto").string();
+    std::filesystem::remove_all(dir);
+    {
+        MyContainer<std::string> c;
+        c.open_persistent(dir, 3);
+        for (auto w : {"a", "bb", "ccc", "dddd", "eeeee", "ffffff", "g"}) {
+            c.addElement(w);
+        }
+    }
+    size_t files = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+        (void)entry;
+        ++files;
+    }
+    CHECK(files == 2);
+    CHECK(std::filesystem::exists(dir + "/snapshot.3"));
+    MyContainer<std::string> recovered;
+    recovered.open_persistent(dir);
+    CHECK(recovered.size() == 7);
+    CHECK(*recovered.begin_descending_order() == "g");
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief Test background checkpoints and recovery across a log chain.
+ * 
+ * Periodic checkpoints switch logs on the mutation path and write the
+ * snapshot on a worker; a missing value is rejected without touching the
+ * log. A directory left with snapshot.G, log.G and log.G+1, as after a
+ * crash mid-checkpoint, recovers every mutation.
+ */
+TEST_CASE("Test persistent container checkpoints in the background") {
+    std::string dir = (std::filesystem::temp_directory_path() / "mycontainer_persist_background").string();
+    std::filesystem::remove_all(dir);
+    {
+        MyContainer<int> c;
+        c.open_persistent(dir, 4);
+        for (int i = 0; i < 10; ++i) {
+            c.addElement(i);
+        }
+        c.wait_for_checkpoint();
+        CHECK(std::filesystem::exists(dir + "/snapshot.3"));
+        CHECK_FALSE(std::filesystem::exists(dir + "/snapshot.2"));
+        CHECK_FALSE(std::filesystem::exists(dir + "/log.2"));
+        auto log_size = std::filesystem::file_size(dir + "/log.3");
+        CHECK_THROWS_AS(c.remove(99), std::runtime_error);
+        CHECK(std::filesystem::file_size(dir + "/log.3") == log_size);
+        c.close_persistent();
+        CHECK_THROWS_AS(c.wait_for_checkpoint(), std::runtime_error);
+    }
+    {
+        detail::OperationLog<int> next(dir + "/log.4");
+        next.append(detail::OperationLog<int>::Op::Add, 100);
+        next.append(detail::OperationLog<int>::Op::Remove, 0);
+    }
+    MyContainer<int> recovered;
+    recovered.open_persistent(dir);
+    CHECK(recovered.get_data() == std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8, 9, 100}));
+    recovered.close_persistent();
+    size_t files = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+        (void)entry;
+        ++files;
+    }
+    CHECK(files == 2);
+    CHECK(std::filesystem::exists(dir + "/snapshot.5"));
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief Test compressed delta-varint snapshots.
+ * 
+ * Dense integers compress several times; the streaming decoder and load()
+ * both yield the ascending order, including negative and extreme values.
+ */
+TEST_CASE("Test compressed snapshot streams ascending order") {
+    std::string path = (std::filesystem::temp_directory_path() / "mycontainer_compressed_test.bin").string();
+    MyContainer<long long> c;
+    for (long long i = 0; i < 100000; ++i) {
+        c.addElement((i * 7919) % 100003 - 50000);
+    }
+    c.addElement(std::numeric_limits<long long>::min());
+    c.addElement(std::numeric_limits<long long>::max());
+    c.save_compressed(path);
+
+    CompressedSnapshot<long long> compressed(path);
+    CHECK(compressed.size() == c.size());
+    CHECK(compressed.compressed_bytes() * 4 < c.size() * sizeof(long long));
+    CHECK_NOTHROW(compressed.verify());
+    std::vector<long long> streamed;
+    for (auto it = compressed.begin_ascending_order(); it != compressed.end_ascending_order(); ++it) {
+        streamed.push_back(*it);
+    }
+    std::vector<long long> expected(c.get_data().begin(), c.get_data().end());
+    std::sort(expected.begin(), expected.end());
+    CHECK(streamed == expected);
+
+    MyContainer<long long> loaded;
+    loaded.load(path);
+    CHECK(loaded.get_data() == expected);
+    CHECK_THROWS_AS(MappedMyContainer<long long>{path}, std::runtime_error);
+    CHECK_THROWS_AS(CompressedSnapshot<int>{path}, std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+/**
+ * @brief Test zero-copy span export of traversal orders.
+ * 
+ * Spans match the iterator orders, alias the cached ordering across calls
+ * and the storage for insertion order.
+ */
+TEST_CASE("Test ordered_span exports cached orderings") {
+    MyContainer<int> c;
+    for (int v : {7, 15, 6, 1, 2}) {
+        c.addElement(v);
+    }
+    std::span<const int> ascending = c.ordered_span(Order::Ascending);
+    CHECK(std::vector<int>(ascending.begin(), ascending.end()) == std::vector<int>({1, 2, 6, 7, 15}));
+    CHECK(ascending.data() == c.ordered_span(Order::Ascending).data());
+    CHECK(ascending.data() == &*c.begin_ascending_order());
+
+    std::span<const int> crossed = c.ordered_span(Order::SideCross);
+    CHECK(std::vector<int>(crossed.begin(), crossed.end()) == std::vector<int>({1, 15, 2, 7, 6}));
+    CHECK(c.ordered_span(Order::Insertion).data() == c.get_data().data());
+
+    MyContainer<int, ChunkedStorage<int, 4>> chunked;
+    for (int v : {3, 1, 2, 5, 4}) {
+        chunked.addElement(v);
+    }
+    std::span<const int> inserted = chunked.ordered_span(Order::Insertion);
+    CHECK(std::vector<int>(inserted.begin(), inserted.end()) == std::vector<int>({3, 1, 2, 5, 4}));
+    CHECK(chunked.ordered_span(Order::Descending).front() == 5);
+}
+
+/**
+ * @brief Test adopting and releasing storage by move.
+ * 
+ * The container takes over the vector's buffer and release() hands the
+ * same buffer back, leaving the container empty.
+ */
+TEST_CASE("Test adopting and releasing storage") {
+    std::vector<int> values = {7, 15, 6, 1, 2};
+    const int* buffer = values.data();
+    MyContainer<int> c(std::move(values));
+    CHECK(c.get_data().data() == buffer);
+    CHECK(c.size() == 5);
+    CHECK(*c.begin_ascending_order() == 1);
+
+    std::vector<int> released = c.release();
+    CHECK(released.data() == buffer);
+    CHECK(released == std::vector<int>({7, 15, 6, 1, 2}));
+    CHECK(c.size() == 0);
+    CHECK(c.begin_ascending_order() == c.end_ascending_order());
+
+    ChunkedStorage<int, 4> chunks;
+    for (int v : {5, 3, 9, 1, 7, 2}) {
+        chunks.push_back(v);
+    }
+    const int* first = &chunks[0];
+    MyContainer<int, ChunkedStorage<int, 4>> chunked(std::move(chunks));
+    CHECK(&chunked.get_data()[0] == first);
+    CHECK(*chunked.begin_ascending_order() == 1);
+    ChunkedStorage<int, 4> back = chunked.release();
+    CHECK(&back[0] == first);
+    CHECK(back.size() == 6);
+    CHECK(chunked.size() == 0);
+    chunked.addElement(4);
+    CHECK(chunked.get_data()[0] == 4);
+}
+
+/**
+ * @brief Test traversal orders of a non-owning view.
+ * 
+ * Every order matches the owning container over the same elements, and a
+ * caller-supplied permutation is used for the sorted orders.
+ */
+TEST_CASE("Test MyContainerView orders") {
+    auto walk = [](auto it, auto end) {
+        std::vector<int> out;
+        for (; it != end; ++it) out.push_back(*it);
+        return out;
+    };
+    std::vector<int> values = {7, 15, 6, 1, 2};
+    MyContainer<int> c{std::vector<int>(values)};
+    MyContainerView<int> view(values);
+    CHECK(view.size() == 5);
+    CHECK(view.get_data().data() == values.data());
+    CHECK_FALSE(view.has_stored_permutation());
+    CHECK(walk(view.begin_ascending_order(), view.end_ascending_order()) == walk(c.begin_ascending_order(), c.end_ascending_order()));
+    CHECK(walk(view.begin_descending_order(), view.end_descending_order()) == walk(c.begin_descending_order(), c.end_descending_order()));
+    CHECK(walk(view.begin_side_cross_order(), view.end_side_cross_order()) == walk(c.begin_side_cross_order(), c.end_side_cross_order()));
+    CHECK(walk(view.begin_reverse_order(), view.end_reverse_order()) == walk(c.begin_reverse_order(), c.end_reverse_order()));
+    CHECK(walk(view.begin_order(), view.end_order()) == walk(c.begin_order(), c.end_order()));
+    CHECK(walk(view.begin_middle_out_order(), view.end_middle_out_order()) == walk(c.begin_middle_out_order(), c.end_middle_out_order()));
+
+    std::vector<uint64_t> permutation = {3, 4, 2, 0, 1};
+    MyContainerView<int> sorted(values, permutation);
+    CHECK(sorted.has_stored_permutation());
+    CHECK(walk(sorted.begin_ascending_order(), sorted.end_ascending_order()) == std::vector<int>({1, 2, 6, 7, 15}));
+    CHECK_THROWS_AS(MyContainerView<int>(values, std::span<const uint64_t>(permutation.data(), 2)), std::invalid_argument);
+
+    MyContainerView<int> empty(std::span<const int>{});
+    CHECK(empty.begin_ascending_order() == empty.end_ascending_order());
+}
+
+/**
+ * @brief Test the pipelined parse-and-sort loader.
+ * 
+ * The input spans several chunks; the result keeps file order and comes
+ * with the ascending ordering already cached.
+ */
+TEST_CASE("Test parse_sorted_from primes the ascending cache") {
+    std::string path = (std::filesystem::temp_directory_path() / "mycontainer_parse_sorted_test.txt").string();
+    MyContainer<long long> source;
+    for (long long i = 0; i < 400000; ++i) {
+        source.addElement((i * 2654435761LL) % 1000003 - 500000);
+    }
+    {
+        std::ofstream file(path);
+        source.write_to(file, Order::Insertion, OutputFormat::lines());
+    }
+    auto loaded = MyContainer<long long>::parse_sorted_from(path);
+    std::filesystem::remove(path);
+    CHECK(loaded.get_data() == source.get_data());
+    CHECK(loaded.has_cached_ordering(Order::Ascending));
+    std::span<const long long> ascending = loaded.ordered_span(Order::Ascending);
+    std::vector<long long> expected(source.get_data().begin(), source.get_data().end());
+    std::sort(expected.begin(), expected.end());
+    CHECK(std::equal(ascending.begin(), ascending.end(), expected.begin(), expected.end()));
+
+    auto small = MyContainer<int>::parse_sorted_from_buffer("3, -1,7,,42\r\n", ',');
+    CHECK(small.get_data() == std::vector<int>({3, -1, 7, 42}));
+    CHECK(*small.begin_ascending_order() == -1);
+    CHECK(MyContainer<int>::parse_sorted_from_buffer("").size() == 0);
+    CHECK_THROWS_WITH(MyContainer<int>::parse_sorted_from_buffer("1\n2x\n3"), "Invalid number at offset 2");
+}
+
+/**
+ * @brief Test the opt-in instrumentation counters.
+ * 
+ * Cache misses on sorted orders count as sorts, end iterators on an
+ * unchanged container are hits, and remove and copies are accounted.
+ */
+TEST_CASE("Test stats counters") {
+    MyContainer<int> c;
+    for (int v : {7, 15, 6, 1, 2}) {
+        c.addElement(v);
+    }
+    ContainerStats stats = c.stats();
+    CHECK(stats.sorts == 0);
+    CHECK(stats.cache_misses == 0);
+
+    auto first = c.begin_ascending_order();
+    auto last = c.end_ascending_order();
+    CHECK(*first == 1);
+    CHECK(first != last);
+    c.begin_descending_order();
+    c.begin_order();
+    stats = c.stats();
+    CHECK(stats.sorts == 2);
+    CHECK(stats.cache_misses == 3);
+    CHECK(stats.cache_hits == 1);
+    CHECK(stats.elements_copied == 15);
+    CHECK(stats.iterator_bytes_allocated >= 15 * sizeof(int));
+
+    c.addElement(3);
+    c.end_ascending_order();
+    c.remove(15);
+    MyContainer<int> copy(c);
+    stats = c.stats();
+    CHECK(stats.sorts == 3);
+    CHECK(stats.remove_scans == 1);
+    CHECK(stats.elements_scanned == 6);
+    CHECK(stats.elements_copied == 15 + 6 + 5);
+    CHECK(copy.stats().elements_copied == 0);
+
+    c.reset_stats();
+    CHECK(c.stats().sorts == 0);
+    CHECK(c.stats().elements_copied == 0);
+}
+
+/**
+ * @brief Test unsorted orders on elements without operator<.
+ * 
+ * Insertion, reverse and middle-out traversals must not instantiate the
+ * comparisons of the sorted orders.
+ */
+TEST_CASE("Test unsorted orders without operator<") {
+    using Complex = std::complex<double>;
+    auto walk = [](auto it, auto end) {
+        std::vector<Complex> out;
+        for (; it != end; ++it) out.push_back(*it);
+        return out;
+    };
+    MyContainer<Complex> c{std::vector<Complex>{{1, 2}, {3, 4}, {5, 6}}};
+    CHECK(walk(c.begin_order(), c.end_order()) == std::vector<Complex>({{1, 2}, {3, 4}, {5, 6}}));
+    CHECK(walk(c.begin_reverse_order(), c.end_reverse_order()) == std::vector<Complex>({{5, 6}, {3, 4}, {1, 2}}));
+    CHECK(walk(c.begin_middle_out_order(), c.end_middle_out_order()) == std::vector<Complex>({{3, 4}, {5, 6}, {1, 2}}));
+}
+
+/**
+ * @brief Test persistence of elements without operator<.
+ * 
+ * Mutations and checkpoints of a persistent container must not need the
+ * comparison; only an explicitly requested permutation does.
+ */
+TEST_CASE("Test persistence without operator<") {
+    using Complex = std::complex<double>;
+    std::string dir = (std::filesystem::temp_directory_path() / "mycontainer_complex_persist").string();
+    std::filesystem::remove_all(dir);
+    {
+        MyContainer<Complex> c;
+        c.open_persistent(dir, 2);
+        c.addElement({1, 2});
+        c.addElement({3, 4});
+        c.addElement({5, 6});
+        c.remove({3, 4});
+        CHECK_THROWS_AS(c.save(dir + "/sorted.bin", true), std::invalid_argument);
+        CHECK_FALSE(std::filesystem::exists(dir + "/sorted.bin"));
+    }
+    MyContainer<Complex> reopened;
+    reopened.open_persistent(dir);
+    CHECK(std::vector<Complex>(reopened.get_data().begin(), reopened.get_data().end()) == std::vector<Complex>({{1, 2}, {5, 6}}));
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief Test that operator<< honours stream manipulators.
+ * 
+ * Non-default flags bypass the to_chars fast path, and printing needs no
+ * operator< on the elements.
+ */
+TEST_CASE("Test operator<< with stream flags") {
+    MyContainer<double> d{std::vector<double>{1.5, 2, 1e-7, 123456789}};
+    std::ostringstream fixed;
+    fixed << std::fixed << std::setprecision(2) << d;
+    CHECK(fixed.str() == "[1.50, 2.00, 0.00, 123456789.00]");
+
+    MyContainer<int> u{std::vector<int>{255, -3}};
+    std::ostringstream hex;
+    hex << std::hex << std::showbase << u;
+    CHECK(hex.str() == "[0xff, 0xfffffffd]");
+
+    MyContainer<bool> b{std::vector<bool>{true}};
+    std::ostringstream alpha;
+    alpha << std::boolalpha << b;
+    CHECK(alpha.str() == "[true]");
+
+    MyContainer<std::complex<double>> c{std::vector<std::complex<double>>{{1, 2}}};
+    std::ostringstream complex;
+    complex << c;
+    CHECK(complex.str() == "[(1,2)]");
+
+    MyContainer<std::complex<double>> p{std::vector<std::complex<double>>{{1.23456, 2}, {0.5, -7.891}}};
+    std::ostringstream precise;
+    precise << std::setprecision(3) << p;
+    CHECK(precise.str() == "[(1.23,2), (0.5,-7.89)]");
+    std::ostringstream fixed_complex;
+    fixed_complex << std::fixed << std::setprecision(1) << p;
+    CHECK(fixed_complex.str() == "[(1.2,2.0), (0.5,-7.9)]");
+}
+
+/**
+ * @brief Test sharded ascending traversal while producers insert.
+ * 
+ * The range covers exactly one snapshot, and a begin/end loop ends at its
+ * own snapshot even when the container grew between the two calls.
+ */
+TEST_CASE("Test concurrent ascending traversal during insertion") {
+    ConcurrentMyContainer<int> c;
+    for (int i = 0; i < 1000; ++i) {
+        c.addElement(i);
+    }
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 2; ++t) {
+        producers.emplace_back([&c, t] {
+            for (int i = 0; i < 50000; ++i) {
+                c.addElement(t * 1000000 + i);
+            }
+        });
+    }
+    bool sorted = true;
+    bool consistent = true;
+    for (int round = 0; round < 20; ++round) {
+        auto range = c.ascending_order();
+        size_t count = 0;
+        int previous = INT_MIN;
+        for (int v : range) {
+            sorted = sorted && previous <= v;
+            previous = v;
+            ++count;
+        }
+        consistent = consistent && count == range.size() && count >= 1000;
+
+        std::vector<int> walked;
+        auto first = c.begin_ascending_order();
+        c.addElement(-1);
+        for (auto last = c.end_ascending_order(); first != last; ++first) {
+            walked.push_back(*first);
+        }
+        sorted = sorted && std::is_sorted(walked.begin(), walked.end());
+    }
+    for (auto& producer : producers) producer.join();
+    CHECK(sorted);
+    CHECK(consistent);
+}
+
+/**
+ * @brief Test run-length orders match the default container with duplicates and removes.
+ * 
+ * Runs keep insertion order, so all six orders must equal those of
+ * MyContainer<int> after interleaved insertions and removals; runs left
+ * adjacent by a removal are merged.
+ */
+TEST_CASE("Test run-length orders with duplicates and removes") {
+    auto walk = [](auto it, auto end) {
+        std::vector<int> out;
+        for (; it != end; ++it) out.push_back(*it);
+        return out;
+    };
+    MyContainer<int> plain;
+    MyContainer<int, RunLengthStorage<int>> runs;
+    unsigned state = 12345;
+    for (int step = 0; step < 400; ++step) {
+        state = state * 1103515245u + 12345u;
+        int value = static_cast<int>((state >> 16) % 6);
+        if (step % 7 == 6 && runs.get_data().count(value) != 0) {
+            plain.remove(value);
+            runs.remove(value);
+        } else {
+            plain.addElement(value);
+            runs.addElement(value);
+        }
+        if (step % 50 != 49) continue;
+        CHECK(walk(runs.begin_order(), runs.end_order()) == walk(plain.begin_order(), plain.end_order()));
+        CHECK(walk(runs.begin_reverse_order(), runs.end_reverse_order()) == walk(plain.begin_reverse_order(), plain.end_reverse_order()));
+        CHECK(walk(runs.begin_middle_out_order(), runs.end_middle_out_order()) == walk(plain.begin_middle_out_order(), plain.end_middle_out_order()));
+        CHECK(walk(runs.begin_ascending_order(), runs.end_ascending_order()) == walk(plain.begin_ascending_order(), plain.end_ascending_order()));
+        CHECK(walk(runs.begin_descending_order(), runs.end_descending_order()) == walk(plain.begin_descending_order(), plain.end_descending_order()));
+        CHECK(walk(runs.begin_side_cross_order(), runs.end_side_cross_order()) == walk(plain.begin_side_cross_order(), plain.end_side_cross_order()));
+    }
+
+    MyContainer<int, RunLengthStorage<int>> merged;
+    for (int v : {1, 1, 2, 1, 3}) {
+        merged.addElement(v);
+    }
+    CHECK(merged.get_data().runs().size() == 4);
+    merged.remove(2);
+    CHECK(merged.get_data().runs().size() == 2);
+    CHECK(walk(merged.begin_order(), merged.end_order()) == std::vector<int>({1, 1, 1, 3}));
+}
+
+/**
+ * @brief Test run-length removal tombstones and iterator snapshots.
+ *
+ * Removed values stay in the insertion log until tombstones reach half of
+ * it, traversals skip them meanwhile, and iterators keep walking the
+ * storage they were created from after later mutations.
+ */
+TEST_CASE("Test run-length log compaction and iterator snapshots") {
+    auto walk = [](auto it, auto end) {
+        std::vector<int> out;
+        for (; it != end; ++it) out.push_back(*it);
+        return out;
+    };
+    MyContainer<int, RunLengthStorage<int>> c;
+    for (int i = 0; i < 4; ++i) {
+        for (int v : {1, 2, 3, 2}) {
+            c.addElement(v);
+        }
+    }
+    CHECK(c.get_data().log_size() == 16);
+    c.remove(3);
+    CHECK(c.get_data().log_size() == 16);
+    CHECK(walk(c.begin_order(), c.end_order()) == std::vector<int>({1, 2, 2, 1, 2, 2, 1, 2, 2, 1, 2, 2}));
+    CHECK(walk(c.begin_middle_out_order(), c.end_middle_out_order()) == std::vector<int>({1, 2, 2, 2, 2, 1, 1, 2, 2, 2, 2, 1}));
+    CHECK(walk(c.begin_reverse_order(), c.end_reverse_order()) == std::vector<int>({2, 2, 1, 2, 2, 1, 2, 2, 1, 2, 2, 1}));
+
+    auto order = c.begin_order();
+    auto ascending = c.begin_ascending_order();
+    c.remove(2);
+    CHECK(c.get_data().log_size() == 1);
+    CHECK(c.get_data().runs() == std::vector<std::pair<int, size_t>>{{1, 4}});
+    c.addElement(2);
+    CHECK(walk(c.begin_order(), c.end_order()) == std::vector<int>({1, 1, 1, 1, 2}));
+    CHECK(walk(order, c.end_order()) == std::vector<int>({1, 2, 2, 1, 2, 2, 1, 2, 2, 1, 2, 2}));
+    CHECK(walk(ascending, c.end_ascending_order()) == std::vector<int>({1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2}));
+}
+
+/**
+ * @brief Test that headers with an overflowing element count are rejected.
+ * 
+ * count * sizeof(T) wraps around to the stored payload size; load() and
+ * MappedMyContainer must refuse the file instead of trusting the count.
+ */
+TEST_CASE("Test snapshot header count overflow") {
+    std::string path = (std::filesystem::temp_directory_path() / "mycontainer_overflow.bin").string();
+    MyContainer<uint64_t> c;
+    c.addElement(1);
+    c.addElement(2);
+    c.save(path);
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        snapshot::Header header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        header.count = (uint64_t(1) << 61) + 2;
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    MyContainer<uint64_t> loaded;
+    CHECK_THROWS_WITH(loaded.load(path), "Snapshot element size mismatch");
+    CHECK_THROWS_AS(MappedMyContainer<uint64_t>{path}, std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+/**
+ * @brief Test that the snapshot checksum catches payload bit flips.
+ * 
+ * Flipping bit 63 of two adjacent words cancelled out under the old
+ * word-wise FNV-1a; a single flipped bit must be caught as well.
+ */
+TEST_CASE("Test snapshot checksum detects bit flips") {
+    std::string path = (std::filesystem::temp_directory_path() / "mycontainer_bitflip.bin").string();
+    MyContainer<uint64_t> c;
+    for (uint64_t i = 0; i < 64; ++i) {
+        c.addElement(i * 0x9E3779B97F4A7C15ull);
+    }
+    auto flip = [&](size_t byte, unsigned bit) {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekg(byte);
+        char value = static_cast<char>(file.get());
+        file.seekp(byte);
+        file.put(static_cast<char>(value ^ (1 << bit)));
+    };
+
+    c.save(path);
+    flip(sizeof(snapshot::Header) + 8 * 5 + 2, 3);
+    MyContainer<uint64_t> loaded;
+    CHECK_THROWS_WITH(loaded.load(path), "Snapshot checksum mismatch");
+    CHECK_THROWS_AS(MappedMyContainer<uint64_t>(path).verify(), std::runtime_error);
+
+    c.save(path);
+    flip(sizeof(snapshot::Header) + 8 * 7 + 7, 7);
+    flip(sizeof(snapshot::Header) + 8 * 8 + 7, 7);
+    CHECK_THROWS_WITH(loaded.load(path), "Snapshot checksum mismatch");
+    CHECK_THROWS_AS(MappedMyContainer<uint64_t>(path).verify(), std::runtime_error);
+
+    c.save(path);
+    loaded.load(path);
+    CHECK(loaded.size() == 64);
+    std::filesystem::remove(path);
+}